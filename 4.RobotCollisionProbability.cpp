@@ -3,6 +3,14 @@
 #include <cmath>
 #include <algorithm>
 #include <vector>
+#include <limits>
+#include <chrono>
+#include <random>
+#include <thread>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 struct Point{
     double x, y;  // x: horizontal position, y: vertical position
@@ -56,10 +64,10 @@ KEY PARAMETERS:
                s ∈ [0,1] → on the segment
                s < 0 or s > 1 → outside segment (no hit)
 */
-bool raySegmentIntersect(Point origin, Point ray_dir, Point p1, Point p2){
-    
-    // seg_dir: Direction vector from p1 to p2
-    Point seg_dir(p2.x - p1.x, p2.y - p1.y);
+// Returns pos_ray (t) of the hit, or -1 if the ray misses the segment
+// For a unit-length ray_dir, t is the distance to the hit point
+// Segment given as start point p1 and seg_dir = p2 - p1
+double raySegmentHitParamDir(Point origin, Point ray_dir, Point p1, Point seg_dir){
     
     // origin_to_p1: Vector from ray origin to segment start point p1
     Point origin_to_p1(p1.x - origin.x, p1.y - origin.y);
@@ -67,17 +75,26 @@ bool raySegmentIntersect(Point origin, Point ray_dir, Point p1, Point p2){
     // cross_dirs: Check if ray and segment are parallel
     // If cross(ray_dir, seg_dir) ≈ 0, they're parallel → no intersection
     double cross_dirs = cross2D(ray_dir, seg_dir);
-    if(std::abs(cross_dirs) < 1e-10) return false;  // Parallel or anti-parallel
+    if(std::abs(cross_dirs) < 1e-10) return -1;  // Parallel or anti-parallel
     
     // pos_ray (t): How far along the ray is the intersection?
     double pos_ray = cross2D(origin_to_p1, seg_dir) / cross_dirs;
-    if (pos_ray < 1e-10) return false;  // Intersection is behind the ray origin
+    if (pos_ray < 1e-10) return -1;  // Intersection is behind the ray origin
     
     // pos_seg (s): Where along the segment [p1, p2] is the intersection?
     double pos_seg = cross2D(origin_to_p1, ray_dir) / cross_dirs;
-    if (pos_seg < 0 || pos_seg > 1) return false;  // Intersection outside segment endpoints
+    if (pos_seg < 0 || pos_seg > 1) return -1;  // Intersection outside segment endpoints
     
-    return true;  // Ray hits the segment!
+    return pos_ray;  // Ray hits the segment!
+}
+
+double raySegmentHitParam(Point origin, Point ray_dir, Point p1, Point p2){
+    // seg_dir: Direction vector from p1 to p2
+    return raySegmentHitParamDir(origin, ray_dir, p1, Point(p2.x - p1.x, p2.y - p1.y));
+}
+
+bool raySegmentIntersect(Point origin, Point ray_dir, Point p1, Point p2){
+    return raySegmentHitParam(origin, ray_dir, p1, p2) >= 0;
 }
 
 bool rayPolygonIntersect(Point origin, Point ray_dir, Polygon& poly){
@@ -134,6 +151,497 @@ double calculateProbability(Point robot, std::vector<Polygon>& obstacles){
     return (double)hits / samples;
 }
 
+/*
+═══════════════════════════════════════════════════════════════════════════
+UNIFORM GRID ACCELERATION
+═══════════════════════════════════════════════════════════════════════════
+calculateProbability tests every ray against every edge: O(samples · E),
+and recomputes cos/sin for every ray of every robot.
+
+- Direction table: the 'samples' unit vectors are computed once and reused
+- Edge grid: square cells over the bounding box of all obstacle edges;
+  each edge is listed in every cell its bounding box touches
+  (cell_start / cell_edges: one flat array, cell c owns
+   cell_edges[cell_start[c] .. cell_start[c+1]) )
+- Each ray walks only the cells it crosses (DDA, Amanatides & Woo):
+
+      +----+----+----+----+
+      |    |    |  ↗ |    |     step to whichever cell border the ray
+      +----+----+-/--+----+     reaches first (t_max_x vs t_max_y)
+      |    |  ↗ |/   |    |
+      +----+-/--+----+----+
+      |  * ↗ |    |    |    |
+      +----+----+----+----+
+
+- The ray stops at the first cell that holds an edge it hits
+- Any edge the ray hits is listed in the cell that holds the hit point, and
+  the ray passes through that cell, so no hit is missed
+- Cost per ray: O(cells crossed + edges in them) instead of O(E)
+*/
+std::vector<Point> makeDirectionTable(int samples){
+    std::vector<Point> dirs(samples);
+    for(int i = 0; i < samples; i++){
+        double angle = 2 * M_PI * i / samples;
+        dirs[i] = Point(std::cos(angle), std::sin(angle));
+    }
+    return dirs;
+}
+
+// Result of a nearest-hit query: edge = -1 when nothing is hit within range
+// Edges are numbered in obstacle order: polygon 0's edges, then polygon 1's, ...
+struct RayHit{
+    double distance;  // Distance to the hit point (max_range when no hit)
+    int edge;         // Index of the edge hit, -1 if none
+};
+
+class EdgeGrid{
+public:
+    std::vector<Point> edge_p1, edge_p2;  // Edge endpoints
+    std::vector<Point> edge_mid;          // Bounding circle per edge: segment midpoint
+    std::vector<double> edge_half;        //   and half length (radius)
+    double min_x = 0, min_y = 0;          // Grid origin (bottom-left corner)
+    double cell = 1;                      // Cell side length
+    int nx = 0, ny = 0;                   // Cells per axis
+    std::vector<int> cell_start;          // Size nx*ny + 1
+    std::vector<int> cell_edges;          // Edge indices grouped by cell
+    std::vector<double> cell_x1, cell_y1; // SoA copy of each cell_edges entry:
+    std::vector<double> cell_dx, cell_dy; //   p1 and p2 - p1 (see BATCHED API)
+
+    int cellX(double x) const { return std::clamp((int)std::floor((x - min_x) / cell), 0, nx - 1); }
+    int cellY(double y) const { return std::clamp((int)std::floor((y - min_y) / cell), 0, ny - 1); }
+
+    // edges_per_cell: target average edges per cell (cell size scales with it)
+    EdgeGrid(const std::vector<Polygon>& obstacles, double edges_per_cell = 1){
+        for(const auto& poly : obstacles){
+            for(size_t i = 0; i < poly.vertices.size(); i++){
+                edge_p1.push_back(poly.vertices[i]);
+                edge_p2.push_back(poly.vertices[(i+1) % poly.vertices.size()]);
+            }
+        }
+        int E = edge_p1.size();
+        for(int e = 0; e < E; e++){
+            edge_mid.push_back(Point((edge_p1[e].x + edge_p2[e].x) / 2, (edge_p1[e].y + edge_p2[e].y) / 2));
+            edge_half.push_back(std::hypot(edge_p2[e].x - edge_p1[e].x, edge_p2[e].y - edge_p1[e].y) / 2);
+        }
+        if(E == 0) return;
+
+        // Bounding box of all edges
+        double max_x = -std::numeric_limits<double>::infinity(), max_y = max_x;
+        min_x = min_y = std::numeric_limits<double>::infinity();
+        for(int e = 0; e < E; e++){
+            for(const Point& p : {edge_p1[e], edge_p2[e]}){
+                min_x = std::min(min_x, p.x); max_x = std::max(max_x, p.x);
+                min_y = std::min(min_y, p.y); max_y = std::max(max_y, p.y);
+            }
+        }
+
+        // About edges_per_cell edges per cell: sqrt(E / edges_per_cell) cells
+        // along the longer side
+        double extent = std::max({max_x - min_x, max_y - min_y, 1e-9});
+        cell = extent / std::max(1.0, std::ceil(std::sqrt(E / edges_per_cell)));
+        nx = std::max(1, (int)std::ceil((max_x - min_x) / cell));
+        ny = std::max(1, (int)std::ceil((max_y - min_y) / cell));
+
+        // Two passes (count, then fill) build the flat cell -> edges lists
+        cell_start.assign(nx * ny + 1, 0);
+        for(int pass = 0; pass < 2; pass++){
+            std::vector<int> fill;
+            if(pass == 1){
+                for(int c = 0; c < nx * ny; c++) cell_start[c+1] += cell_start[c];
+                cell_edges.resize(cell_start.back());
+                fill.assign(cell_start.begin(), cell_start.end() - 1);
+            }
+            for(int e = 0; e < E; e++){
+                int x0 = cellX(std::min(edge_p1[e].x, edge_p2[e].x));
+                int x1 = cellX(std::max(edge_p1[e].x, edge_p2[e].x));
+                int y0 = cellY(std::min(edge_p1[e].y, edge_p2[e].y));
+                int y1 = cellY(std::max(edge_p1[e].y, edge_p2[e].y));
+                for(int cy = y0; cy <= y1; cy++){
+                    for(int cx = x0; cx <= x1; cx++){
+                        int c = cy * nx + cx;
+                        if(pass == 0) cell_start[c+1]++;
+                        else cell_edges[fill[c]++] = e;
+                    }
+                }
+            }
+        }
+
+        for(int e : cell_edges){
+            cell_x1.push_back(edge_p1[e].x);
+            cell_y1.push_back(edge_p1[e].y);
+            cell_dx.push_back(edge_p2[e].x - edge_p1[e].x);
+            cell_dy.push_back(edge_p2[e].y - edge_p1[e].y);
+        }
+    }
+
+    // Visit the cells a ray crosses, in order, with DDA
+    // visit(c, t_leave) gets the cell index and the t at which the ray leaves
+    // the cell; returning true stops the walk. Nothing is visited if the ray
+    // misses the grid or enters it beyond t_limit
+    template <typename Visit>
+    void walkCells(const Point& origin, const Point& dir, double t_limit, Visit visit) const{
+        if(nx == 0) return;
+        double max_x = min_x + nx * cell, max_y = min_y + ny * cell;
+
+        // Clip the ray to the grid box (slab test) to find where it enters
+        double t_enter = 0, t_exit = std::numeric_limits<double>::infinity();
+        double lo[2] = {min_x, min_y}, hi[2] = {max_x, max_y};
+        double o[2] = {origin.x, origin.y}, d[2] = {dir.x, dir.y};
+        for(int axis = 0; axis < 2; axis++){
+            if(d[axis] == 0){
+                if(o[axis] < lo[axis] || o[axis] > hi[axis]) return;
+                continue;
+            }
+            double ta = (lo[axis] - o[axis]) / d[axis];
+            double tb = (hi[axis] - o[axis]) / d[axis];
+            t_enter = std::max(t_enter, std::min(ta, tb));
+            t_exit = std::min(t_exit, std::max(ta, tb));
+        }
+        if(t_enter > t_exit || t_enter > t_limit) return;  // Ray misses the grid
+
+        int ix = cellX(origin.x + dir.x * t_enter);
+        int iy = cellY(origin.y + dir.y * t_enter);
+        int step_x = dir.x > 0 ? 1 : -1;
+        int step_y = dir.y > 0 ? 1 : -1;
+
+        // t at which the ray crosses the next vertical / horizontal cell border
+        double inf = std::numeric_limits<double>::infinity();
+        double t_max_x = dir.x == 0 ? inf : (min_x + (ix + (dir.x > 0)) * cell - origin.x) / dir.x;
+        double t_max_y = dir.y == 0 ? inf : (min_y + (iy + (dir.y > 0)) * cell - origin.y) / dir.y;
+        double t_delta_x = dir.x == 0 ? inf : cell / std::abs(dir.x);
+        double t_delta_y = dir.y == 0 ? inf : cell / std::abs(dir.y);
+
+        while(true){
+            if(visit(iy * nx + ix, std::min(t_max_x, t_max_y))) return;
+
+            // Step into the neighbouring cell whose border comes first
+            if(t_max_x < t_max_y){
+                ix += step_x;
+                if(ix < 0 || ix >= nx) return;
+                t_max_x += t_delta_x;
+            }
+            else{
+                iy += step_y;
+                if(iy < 0 || iy >= ny) return;
+                t_max_y += t_delta_y;
+            }
+        }
+    }
+
+    // Nearest edge along a unit-length ray within max_range (see RANGE SCAN)
+    RayHit nearestHit(const Point& origin, const Point& dir,
+                      double max_range = std::numeric_limits<double>::infinity()) const;
+
+    // Does the ray hit any edge? Walks the crossed cells with DDA
+    bool rayHitsAny(const Point& origin, const Point& dir) const{
+        bool hit = false;
+        walkCells(origin, dir, std::numeric_limits<double>::infinity(), [&](int c, double){
+            for(int k = cell_start[c]; k < cell_start[c+1] && !hit; k++){
+                int e = cell_edges[k];
+                hit = raySegmentIntersect(origin, dir, edge_p1[e], edge_p2[e]);
+            }
+            return hit;
+        });
+        return hit;
+    }
+
+    // Same as rayHitsAny, testing each cell's SoA edges with the AVX2 kernel
+    bool rayHitsAnySIMD(const Point& origin, const Point& dir) const;
+};
+
+// Same result as calculateProbability, using the direction table and edge grid
+double calculateProbabilityGrid(Point robot, const EdgeGrid& grid, const std::vector<Point>& dirs){
+    int hits = 0;
+    for(const Point& dir : dirs){
+        if(grid.rayHitsAny(robot, dir)) hits += 1;
+    }
+    return (double)hits / dirs.size();
+}
+
+/*
+═══════════════════════════════════════════════════════════════════════════
+EXACT ANGULAR COVERAGE
+═══════════════════════════════════════════════════════════════════════════
+Sampling 360 rays has a 1° resolution: a thin obstacle between two rays is
+missed, and the answer is only accurate to about ±1/360 per obstacle.
+
+Exact version: an edge seen from the robot covers an angular interval,
+the shorter arc between the angles of its two endpoints:
+
+          p2
+          /        interval = [angle(p1), angle(p2)]
+         /         (always < 180° unless the robot lies on the edge line)
+        /
+      p1
+     ↗
+    *  robot
+
+- A polygon's edges together cover the polygon's angular interval(s)
+- Intervals crossing 0° / 360° are split in two: [a, 2π) and [0, b]
+- Sort all intervals by start and sweep, merging overlaps (union length)
+- Probability = covered length / 2π
+
+Edges collinear with the robot cover zero angle and are skipped.
+Complexity: O(E log E) for E edges, independent of any sample count
+*/
+double calculateProbabilityExact(Point robot, const std::vector<Polygon>& obstacles){
+    const double TWO_PI = 2 * M_PI;
+    std::vector<std::pair<double, double>> intervals;  // [start, end] in [0, 2π]
+
+    for(const auto& poly : obstacles){
+        for(size_t i = 0; i < poly.vertices.size(); i++){
+            Point p1 = poly.vertices[i];
+            Point p2 = poly.vertices[(i+1) % poly.vertices.size()];
+            double a1 = std::atan2(p1.y - robot.y, p1.x - robot.x);
+            double a2 = std::atan2(p2.y - robot.y, p2.x - robot.x);
+
+            // Signed sweep from a1 to a2, folded into (-π, π]
+            double span = a2 - a1;
+            if(span > M_PI) span -= TWO_PI;
+            if(span <= -M_PI) span += TWO_PI;
+            double start = span >= 0 ? a1 : a2;
+            span = std::abs(span);
+            if(span == 0) continue;  // Edge points straight at the robot
+
+            if(start < 0) start += TWO_PI;
+            double end = start + span;
+            if(end > TWO_PI){
+                intervals.push_back({start, TWO_PI});  // Wraps past 360°
+                intervals.push_back({0, end - TWO_PI});
+            }
+            else{
+                intervals.push_back({start, end});
+            }
+        }
+    }
+
+    // Sort-and-sweep union of the intervals
+    std::sort(intervals.begin(), intervals.end());
+    double covered = 0;
+    double cur_start = 0, cur_end = -1;  // Current merged run (empty)
+    for(const auto& [a, b] : intervals){
+        if(a > cur_end){
+            if(cur_end > cur_start) covered += cur_end - cur_start;
+            cur_start = a;
+            cur_end = b;
+        }
+        else{
+            cur_end = std::max(cur_end, b);
+        }
+    }
+    if(cur_end > cur_start) covered += cur_end - cur_start;
+
+    return std::min(1.0, covered / TWO_PI);
+}
+
+/*
+═══════════════════════════════════════════════════════════════════════════
+BATCHED MULTI-ROBOT API (SoA + AVX2)
+═══════════════════════════════════════════════════════════════════════════
+Many robots against the same obstacle set:
+
+- Edges are stored in Structure-of-Arrays form:
+      x1[]: p1.x of every edge    dx[]: p2.x - p1.x
+      y1[]: p1.y of every edge    dy[]: p2.y - p1.y
+  so 4 consecutive edges load straight into one 256-bit register
+- One ray is tested against 4 edges per AVX2 step: the same cross products
+  as raySegmentIntersect, with the three rejection tests turned into masks
+      |cross_dirs| >= 1e-10  AND  pos_ray >= 1e-10  AND  0 <= pos_seg <= 1
+  → any lane set = the ray is blocked
+- Fast path: the EdgeGrid keeps every cell's edge list in this SoA form;
+  each ray walks its cells with DDA and runs the kernel on each cell's
+  edges. The batch grid uses coarser cells (BATCH_EDGES_PER_CELL) so a
+  cell holds a few full SIMD steps rather than one edge
+- EdgeSoA / rayHitsAnySoA run the kernel over ALL edges: O(samples · E),
+  the brute-force SIMD reference, not the path to use for many robots
+- Robots are split into contiguous chunks, one per thread; each robot
+  writes only its own result slot, so the output does not depend on the
+  thread count
+- Scalar loop when built without AVX2 (use -mavx2 or -march=native)
+*/
+// Average edges per cell of the grid built by calculateProbabilityBatch
+const double BATCH_EDGES_PER_CELL = 8;
+
+struct EdgeSoA{
+    std::vector<double> x1, y1, dx, dy;
+
+    EdgeSoA(const std::vector<Polygon>& obstacles){
+        for(const auto& poly : obstacles){
+            for(size_t i = 0; i < poly.vertices.size(); i++){
+                Point p1 = poly.vertices[i];
+                Point p2 = poly.vertices[(i+1) % poly.vertices.size()];
+                x1.push_back(p1.x);
+                y1.push_back(p1.y);
+                dx.push_back(p2.x - p1.x);
+                dy.push_back(p2.y - p1.y);
+            }
+        }
+    }
+
+    size_t size() const { return x1.size(); }
+};
+
+// Does the ray hit any of the n edges x1[i], y1[i], dx[i], dy[i]?
+// Same tests as raySegmentIntersect, 4 edges per step
+bool rayHitsAnyEdges(const Point& origin, const Point& dir, const double* x1, const double* y1,
+                     const double* dx, const double* dy, size_t n){
+    size_t i = 0;
+#ifdef __AVX2__
+    __m256d ox = _mm256_set1_pd(origin.x), oy = _mm256_set1_pd(origin.y);
+    __m256d rx = _mm256_set1_pd(dir.x), ry = _mm256_set1_pd(dir.y);
+    __m256d eps = _mm256_set1_pd(1e-10);
+    __m256d zero = _mm256_setzero_pd(), one = _mm256_set1_pd(1.0);
+    __m256d sign = _mm256_set1_pd(-0.0);
+    for(; i + 4 <= n; i += 4){
+        __m256d sx = _mm256_loadu_pd(dx + i);
+        __m256d sy = _mm256_loadu_pd(dy + i);
+        __m256d px = _mm256_sub_pd(_mm256_loadu_pd(x1 + i), ox);  // origin_to_p1
+        __m256d py = _mm256_sub_pd(_mm256_loadu_pd(y1 + i), oy);
+
+        __m256d cross_dirs = _mm256_sub_pd(_mm256_mul_pd(rx, sy), _mm256_mul_pd(ry, sx));
+        __m256d pos_ray = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(px, sy), _mm256_mul_pd(py, sx)), cross_dirs);
+        __m256d pos_seg = _mm256_div_pd(_mm256_sub_pd(_mm256_mul_pd(px, ry), _mm256_mul_pd(py, rx)), cross_dirs);
+
+        __m256d hit = _mm256_cmp_pd(_mm256_andnot_pd(sign, cross_dirs), eps, _CMP_GE_OQ);
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(pos_ray, eps, _CMP_GE_OQ));
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(pos_seg, zero, _CMP_GE_OQ));
+        hit = _mm256_and_pd(hit, _mm256_cmp_pd(pos_seg, one, _CMP_LE_OQ));
+        if(_mm256_movemask_pd(hit)) return true;
+    }
+#endif
+    // Tail uses the stored dx, dy like the SIMD lanes (p2 - p1 could round differently)
+    for(; i < n; i++){
+        Point p1(x1[i], y1[i]);
+        Point seg_dir(dx[i], dy[i]);
+        if(raySegmentHitParamDir(origin, dir, p1, seg_dir) >= 0) return true;
+    }
+    return false;
+}
+
+// Brute force: every edge of the scene (reference for the grid path)
+bool rayHitsAnySoA(const Point& origin, const Point& dir, const EdgeSoA& edges){
+    return rayHitsAnyEdges(origin, dir, edges.x1.data(), edges.y1.data(),
+                           edges.dx.data(), edges.dy.data(), edges.size());
+}
+
+// Grid walk, SIMD test of each crossed cell's edges
+bool EdgeGrid::rayHitsAnySIMD(const Point& origin, const Point& dir) const{
+    bool hit = false;
+    walkCells(origin, dir, std::numeric_limits<double>::infinity(), [&](int c, double){
+        size_t first = cell_start[c], count = cell_start[c+1] - cell_start[c];
+        hit = rayHitsAnyEdges(origin, dir, &cell_x1[first], &cell_y1[first],
+                              &cell_dx[first], &cell_dy[first], count);
+        return hit;
+    });
+    return hit;
+}
+
+// Split [0, n) into contiguous chunks, one per thread; work(begin, end) per chunk
+template <typename Work>
+void forEachRobotChunk(size_t n, unsigned num_threads, Work work){
+    num_threads = std::max(1u, std::min<unsigned>(num_threads, n));
+    size_t chunk = (n + num_threads - 1) / num_threads;
+    std::vector<std::thread> threads;
+    for(unsigned t = 1; t < num_threads; t++){
+        threads.emplace_back(work, std::min(n, t * chunk), std::min(n, (t + 1) * chunk));
+    }
+    work(0, std::min(n, chunk));  // Calling thread takes the first chunk
+    for(auto& th : threads) th.join();
+}
+
+// Probability for every robot; result[i] matches calculateProbability(robots[i], ...)
+std::vector<double> calculateProbabilityBatch(const std::vector<Point>& robots,
+                                              const std::vector<Polygon>& obstacles,
+                                              int samples = 360,
+                                              unsigned num_threads = std::thread::hardware_concurrency()){
+    EdgeGrid grid(obstacles, BATCH_EDGES_PER_CELL);
+    std::vector<Point> dirs = makeDirectionTable(samples);
+    std::vector<double> result(robots.size());
+
+    forEachRobotChunk(robots.size(), num_threads, [&](size_t begin, size_t end){
+        for(size_t r = begin; r < end; r++){
+            int hits = 0;
+            for(const Point& dir : dirs){
+                if(grid.rayHitsAnySIMD(robots[r], dir)) hits += 1;
+            }
+            result[r] = (double)hits / samples;
+        }
+    });
+    return result;
+}
+
+/*
+═══════════════════════════════════════════════════════════════════════════
+RANGE SCAN (NEAREST HIT)
+═══════════════════════════════════════════════════════════════════════════
+A lidar needs more than hit / no hit: the distance to the NEAREST edge
+along each beam, and which edge it was.
+
+- raySegmentHitParam returns pos_ray (t) instead of a bool
+- nearestHit walks the grid with DDA like rayHitsAny, keeping the best t:
+
+      best = max_range
+      for each crossed cell:
+          test its edges, best = min(best, t)
+          stop once best <= t where the ray leaves the cell
+                    (nothing further along can be nearer)
+
+- An edge whose bounding circle (midpoint, half length) lies entirely
+  beyond 'best' is skipped without the intersection test
+- Starting best at max_range cuts the walk off at the sensor range, so a
+  short-range scan touches only the cells within that radius
+- rangeScan fills one RayHit per direction (a synthetic 360° lidar frame);
+  rangeScanBatch does it for many robots, one contiguous chunk per thread
+*/
+RayHit EdgeGrid::nearestHit(const Point& origin, const Point& dir, double max_range) const{
+    RayHit best{max_range, -1};
+    walkCells(origin, dir, max_range, [&](int c, double t_leave){
+        for(int k = cell_start[c]; k < cell_start[c+1]; k++){
+            int e = cell_edges[k];
+
+            // Bounding circle entirely farther than the current best → skip
+            double mx = edge_mid[e].x - origin.x, my = edge_mid[e].y - origin.y;
+            double reach = best.distance + edge_half[e];
+            if(mx * mx + my * my > reach * reach) continue;
+
+            double t = raySegmentHitParam(origin, dir, edge_p1[e], edge_p2[e]);
+            if(t >= 0 && t <= best.distance && (t < best.distance || best.edge < 0)){
+                best = {t, e};
+            }
+        }
+
+        // The ray leaves this cell at t_leave; any later hit is farther
+        return best.distance <= t_leave;
+    });
+    return best;
+}
+
+// One lidar frame: scan[i] is the nearest hit along dirs[i] (unit vectors)
+std::vector<RayHit> rangeScan(Point robot, const EdgeGrid& grid, const std::vector<Point>& dirs,
+                              double max_range = std::numeric_limits<double>::infinity()){
+    std::vector<RayHit> scan(dirs.size());
+    for(size_t i = 0; i < dirs.size(); i++){
+        scan[i] = grid.nearestHit(robot, dirs[i], max_range);
+    }
+    return scan;
+}
+
+// Frames for many robots, flattened: scans[r * dirs.size() + i]
+std::vector<RayHit> rangeScanBatch(const std::vector<Point>& robots, const EdgeGrid& grid,
+                                   const std::vector<Point>& dirs,
+                                   double max_range = std::numeric_limits<double>::infinity(),
+                                   unsigned num_threads = std::thread::hardware_concurrency()){
+    std::vector<RayHit> scans(robots.size() * dirs.size());
+    forEachRobotChunk(robots.size(), num_threads, [&](size_t begin, size_t end){
+        for(size_t r = begin; r < end; r++){
+            for(size_t i = 0; i < dirs.size(); i++){
+                scans[r * dirs.size() + i] = grid.nearestHit(robots[r], dirs[i], max_range);
+            }
+        }
+    });
+    return scans;
+}
+
 int main(){
     Point robot(0, 0);
     // Note: Vertices must be in order (clockwise or counter-clockwise)
@@ -150,5 +658,98 @@ int main(){
     std::cout << "Blocked angle: " << prob * 2 * M_PI << " radians" << std::endl;
     std::cout << "Blocked angle: " << prob * 360 << " degrees" << std::endl;
 
+    // Exact coverage: 2·atan(1/3) = 36.87°, which 1° sampling rounds to 37°
+    double exact = calculateProbabilityExact(robot, obstacles);
+    std::cout << "Exact blocked angle: " << exact * 360 << " degrees (expected: 36.8699)" << std::endl;
+
+    // Grid-accelerated version on a large scene: 25k small squares = 100k edges
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> coord(-500, 500);
+    std::vector<Polygon> scene;
+    for(int i = 0; i < 25000; i++){
+        double x = coord(rng), y = coord(rng);
+        Polygon box;
+        box.vertices = {Point(x, y), Point(x + 1, y), Point(x + 1, y + 1), Point(x, y + 1)};
+        scene.push_back(box);
+    }
+    std::vector<Point> robots;
+    for(int i = 0; i < 20; i++) robots.push_back(Point(coord(rng), coord(rng)));
+
+    auto t0 = std::chrono::steady_clock::now();
+    EdgeGrid grid(scene);
+    std::vector<Point> dirs = makeDirectionTable(360);
+    auto t1 = std::chrono::steady_clock::now();
+    std::vector<double> fast;
+    for(const Point& r : robots) fast.push_back(calculateProbabilityGrid(r, grid, dirs));
+    auto t2 = std::chrono::steady_clock::now();
+    int mismatches = 0;
+    for(size_t i = 0; i < robots.size(); i++){
+        if(calculateProbability(robots[i], scene) != fast[i]) mismatches++;
+    }
+    auto t3 = std::chrono::steady_clock::now();
+
+    auto us = [](std::chrono::steady_clock::duration d){
+        return std::chrono::duration<double, std::micro>(d).count();
+    };
+    std::cout << "\n100k edges, " << robots.size() << " robots" << std::endl;
+    std::cout << "Grid build: " << us(t1 - t0) / 1000 << " ms" << std::endl;
+    std::cout << "Grid:       " << us(t2 - t1) / robots.size() << " us/robot" << std::endl;
+    std::cout << "Brute:      " << us(t3 - t2) / robots.size() << " us/robot" << std::endl;
+    std::cout << "Mismatches: " << mismatches << " (expected: 0)" << std::endl;
+
+    auto t4 = std::chrono::steady_clock::now();
+    double max_diff = 0;
+    for(size_t i = 0; i < robots.size(); i++){
+        max_diff = std::max(max_diff, std::abs(calculateProbabilityExact(robots[i], scene) - fast[i]));
+    }
+    auto t5 = std::chrono::steady_clock::now();
+    std::cout << "Exact:      " << us(t5 - t4) / robots.size() << " us/robot"
+              << ", max |exact - sampled| = " << max_diff << std::endl;
+
+    // Batched grid + SoA/AVX2 version: 1000 robots at once (grid build included)
+    std::vector<Point> many;
+    for(int i = 0; i < 1000; i++) many.push_back(Point(coord(rng), coord(rng)));
+    auto t6 = std::chrono::steady_clock::now();
+    std::vector<double> batch = calculateProbabilityBatch(many, scene);
+    auto t7 = std::chrono::steady_clock::now();
+    int batch_mismatches = 0;
+    for(size_t i = 0; i < many.size(); i++){
+        if(batch[i] != calculateProbabilityGrid(many[i], grid, dirs)) batch_mismatches++;
+    }
+    auto t8 = std::chrono::steady_clock::now();
+
+    // Brute-force SIMD reference (every edge per ray) on the first robots
+    EdgeSoA all_edges(scene);
+    const size_t BRUTE_ROBOTS = 10;
+    auto t9 = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < BRUTE_ROBOTS; i++){
+        int hits = 0;
+        for(const Point& dir : dirs) hits += rayHitsAnySoA(many[i], dir, all_edges);
+        if((double)hits / dirs.size() != batch[i]) batch_mismatches++;
+    }
+    auto t10 = std::chrono::steady_clock::now();
+    std::cout << "Batch grid: " << us(t7 - t6) / many.size() << " us/robot over " << many.size()
+              << " robots (grid scalar: " << us(t8 - t7) / many.size() << ")" << std::endl;
+    std::cout << "Brute SoA:  " << us(t10 - t9) / BRUTE_ROBOTS << " us/robot"
+              << ", mismatches: " << batch_mismatches << " (expected: 0)" << std::endl;
+
+    // Synthetic lidar: the original example, nearest hit straight ahead
+    EdgeGrid small_grid(obstacles);
+    RayHit ahead = small_grid.nearestHit(robot, Point(1, 0));
+    std::cout << "\nNearest hit at 0°: distance " << ahead.distance << ", edge " << ahead.edge
+              << " (expected: 3, edge 3)" << std::endl;
+
+    // 300 robots, 360 beams, 30 m range on the 100k-edge scene
+    std::vector<Point> fleet;
+    for(int i = 0; i < 300; i++) fleet.push_back(Point(coord(rng), coord(rng)));
+    auto t11 = std::chrono::steady_clock::now();
+    std::vector<RayHit> scans = rangeScanBatch(fleet, grid, dirs, 30.0);
+    auto t12 = std::chrono::steady_clock::now();
+    int beams_hit = 0;
+    for(const RayHit& h : scans) if(h.edge >= 0) beams_hit++;
+    std::cout << fleet.size() << " robots x " << dirs.size() << " beams: "
+              << us(t12 - t11) / 1000 << " ms per frame, "
+              << beams_hit << " / " << scans.size() << " beams hit within 30" << std::endl;
+
     return 0;
 }
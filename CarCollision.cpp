@@ -32,11 +32,80 @@
  * COMPLEXITY:
  * - Time: O(n^2 * T/dt) where n = number of vehicles, T = collision time
  * - Space: O(n)
+ * 
+ * EXACT TIME OF IMPACT (findFirstCollisionExact):
+ * - With constant velocities the gap between two centers is linear in t:
+ *     d(t) = p + v*t   (p = relative position, v = relative velocity)
+ * - Contact when |d(t)| = ra + rb, a quadratic in t:
+ *     (v.v) t^2 + 2 (p.v) t + (p.p - R^2) = 0
+ * - The smaller root is the first contact; no time stepping, so fast
+ *   vehicles cannot tunnel through each other between steps
+ * - Time: O(n^2), independent of dt and of the collision time
+ * 
+ * BROAD PHASE (findFirstCollisionSAP):
+ * - Sweep-and-prune: each vehicle's swept x-interval over one step
+ *   [min(x, x + dx*dt) - r, max(x, x + dx*dt) + r] is kept in an array
+ *   sorted by its low end
+ * - Between steps vehicles move a little, so the order is nearly sorted and
+ *   insertion sort fixes it in ~O(n + swaps)
+ * - One sweep over the sorted intervals yields the pairs whose x-intervals
+ *   overlap; only those reach the narrow collides() test
+ * - Time: O((n + k) * T/dt) where k = overlapping pairs per step
+ * 
+ * EVENT-DRIVEN SIMULATION (EventDrivenSimulator):
+ * - No fixed dt: every pair's next contact is predicted with timeOfImpact and
+ *   pushed into a min-priority queue keyed by event time
+ * - Velocity changes (maneuvers) are events too; a maneuver bumps the
+ *   vehicle's version counter and re-predicts its pairs
+ * - Stale predictions are not searched for and removed: each contact event
+ *   remembers both versions and is skipped when popped if either changed
+ * - Time jumps straight from event to event
+ * - Time: O(n^2 log n) to seed, then O(n log n) per maneuver and
+ *   O(log n) per contact, independent of the horizon
+ * 
+ * ALL COLLISIONS, MULTI-THREADED (findAllCollisions):
+ * - Does not print or modify the input; positions at step k are computed
+ *   directly as x0 + dx * k*dt
+ * - Vehicles are bucketed into a uniform grid (cell = largest diameter) and
+ *   sorted by cell; threads take disjoint ranges of cells and test each cell
+ *   against itself and 4 forward neighbours, so every pair is seen once
+ * - Per-thread hit buffers are concatenated and sorted by pair, so the
+ *   output does not depend on thread count or scheduling
+ * - A collision is reported at the first step of each contact episode
+ * - Time: O((n log n + k) * T/dt / p) per step, p = threads, k = close pairs
+ * 
+ * SoA + SIMD (VehicleStore / findFirstCollisionSoA):
+ * - Vehicle fields live in separate contiguous arrays (x[], y[], dx[], ...),
+ *   so 4 vehicles load with one 256-bit instruction
+ * - Integration x += dx*dt and the overlap test
+ *   (xb-xa)^2 + (yb-ya)^2 <= (ra+rb)^2 (no sqrt) run 4 doubles at a time
+ *   with AVX2 (build with -mavx2 or -march=native); scalar loop otherwise
+ * - Same pair order and results as findFirstCollision
+ * 
+ * SHAPED VEHICLES (ShapedVehicle / findFirstCollisionShaped):
+ * - A circle around a long truck covers the neighbouring lanes too, giving
+ *   false collisions
+ * - Oriented rectangles and convex polygons are stored as vertices in the
+ *   vehicle frame plus a heading; Vehicle::r becomes the bounding radius
+ * - Cheap rejection first: bounding circles apart -> no collision
+ * - Narrow phase: separating axis theorem (SAT); two convex shapes are
+ *   disjoint iff their projections are disjoint on some edge normal
+ *   (plus the center-to-nearest-vertex axis when one side is a circle)
+ * - Time: O(1) per rejected pair, O(ea + eb) per SAT test (e = edges)
  */
 
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <queue>
+#include <thread>
+#include <cstdint>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -116,6 +185,682 @@ double findFirstCollision(vector<Vehicle>& vehicles, double dt, double max_time)
     return -1;
 }
 
+/**
+ * Exact first contact time of two constant-velocity circles
+ * 
+ * Solves |p + v*t| = ra + rb for the smallest t >= 0, where p and v are
+ * b's position and velocity relative to a
+ * 
+ * @param a First vehicle
+ * @param b Second vehicle
+ * @return Time of first contact (0 if already touching), or -1 if never
+ */
+double timeOfImpact(const Vehicle& a, const Vehicle& b) {
+    double px = b.x - a.x, py = b.y - a.y;     // Relative position
+    double vx = b.dx - a.dx, vy = b.dy - a.dy; // Relative velocity
+    double R = a.r + b.r;
+    
+    double c = px*px + py*py - R*R;
+    if (c <= 0) return 0;                      // Already overlapping
+    
+    double pv = px*vx + py*vy;
+    if (pv >= 0) return -1;                    // Not approaching (or not moving)
+    
+    double vv = vx*vx + vy*vy;
+    double disc = pv*pv - vv*c;                // Quarter discriminant
+    if (disc < 0) return -1;                   // Closest approach is still > R
+    
+    return (-pv - sqrt(disc)) / vv;            // Earlier root = first contact
+}
+
+/**
+ * Find the first collision time exactly, without time stepping
+ * 
+ * Computes the time of impact of every pair and keeps the earliest one
+ * within the horizon. Vehicles are not modified.
+ * 
+ * @param vehicles List of vehicles (positions at t=0)
+ * @param max_time Maximum simulation time (seconds)
+ * @return Time of first collision, or -1 if no collision occurs
+ */
+double findFirstCollisionExact(const vector<Vehicle>& vehicles, double max_time) {
+    double first = -1;
+    int first_a = -1, first_b = -1;
+    
+    for (size_t i = 0; i < vehicles.size(); i++) {
+        for (size_t j = i + 1; j < vehicles.size(); j++) {
+            double t = timeOfImpact(vehicles[i], vehicles[j]);
+            if (t >= 0 && t <= max_time && (first < 0 || t < first)) {
+                first = t;
+                first_a = vehicles[i].id;
+                first_b = vehicles[j].id;
+            }
+        }
+    }
+    
+    if (first < 0) {
+        printf("No collision within %.1fs\n", max_time);
+    } else {
+        printf("Collision at t=%.4f between vehicles %d and %d\n", first, first_a, first_b);
+    }
+    return first;
+}
+
+/**
+ * Sweep-and-prune broad phase along the x axis
+ * 
+ * Keeps vehicle indices ordered by the low end of their swept x-interval.
+ * The first step sorts with std::sort; the order then persists between
+ * steps, so re-sorting after a step is an insertion sort over nearly
+ * sorted data.
+ */
+class SweepAndPrune {
+private:
+    vector<int> order;      // Vehicle indices sorted by lo
+    vector<double> lo, hi;  // Swept x-interval per vehicle
+    vector<int> active;     // Scratch: intervals still open during the sweep
+
+public:
+    /**
+     * Recompute swept intervals for the step [t, t + dt] and restore order
+     * 
+     * @param vehicles Vehicles at the start of the step
+     * @param dt Timestep duration (seconds)
+     */
+    void update(const vector<Vehicle>& vehicles, double dt) {
+        size_t n = vehicles.size();
+        lo.resize(n);
+        hi.resize(n);
+        
+        for (size_t i = 0; i < n; i++) {
+            double x_end = vehicles[i].x + vehicles[i].dx * dt;
+            lo[i] = min(vehicles[i].x, x_end) - vehicles[i].r;
+            hi[i] = max(vehicles[i].x, x_end) + vehicles[i].r;
+        }
+        
+        // First step (or vehicle count changed): full O(n log n) sort
+        if (order.size() != n) {
+            order.resize(n);
+            for (size_t i = 0; i < n; i++) order[i] = i;
+            sort(order.begin(), order.end(), [&](int a, int b) { return lo[a] < lo[b]; });
+            return;
+        }
+        
+        // Later steps: insertion sort, O(n) when few vehicles overtook each other
+        for (size_t i = 1; i < n; i++) {
+            int v = order[i];
+            size_t j = i;
+            while (j > 0 && lo[order[j - 1]] > lo[v]) {
+                order[j] = order[j - 1];
+                j--;
+            }
+            order[j] = v;
+        }
+    }
+    
+    /**
+     * Call visit(i, j) for every pair whose swept x-intervals overlap
+     * Stops early (and returns true) as soon as visit returns true
+     */
+    template <typename Visit>
+    bool forEachCandidate(Visit visit) {
+        active.clear();
+        for (int v : order) {
+            // Drop intervals that ended before this one starts
+            size_t keep = 0;
+            for (int a : active) {
+                if (hi[a] >= lo[v]) active[keep++] = a;
+            }
+            active.resize(keep);
+            
+            for (int a : active) {
+                if (visit(a, v)) return true;
+            }
+            active.push_back(v);
+        }
+        return false;
+    }
+};
+
+/**
+ * Same simulation as findFirstCollision, with a sweep-and-prune broad phase
+ * 
+ * @param vehicles List of vehicles to simulate (modified in-place)
+ * @param dt Timestep duration (seconds)
+ * @param max_time Maximum simulation time (seconds)
+ * @return Time of first collision, or -1 if no collision occurs
+ */
+double findFirstCollisionSAP(vector<Vehicle>& vehicles, double dt, double max_time) {
+    SweepAndPrune sap;
+    double t = 0;
+    
+    while (t < max_time) {
+        sap.update(vehicles, dt);
+        
+        // Narrow phase only on candidates from the broad phase
+        int hit_a = -1, hit_b = -1;
+        bool hit = sap.forEachCandidate([&](int a, int b) {
+            if (collides(vehicles[a], vehicles[b])) {
+                hit_a = min(vehicles[a].id, vehicles[b].id);
+                hit_b = max(vehicles[a].id, vehicles[b].id);
+                return true;
+            }
+            return false;
+        });
+        if (hit) {
+            printf("Collision at t=%.2f between vehicles %d and %d\n", t, hit_a, hit_b);
+            return t;
+        }
+        
+        for (auto& v : vehicles) {
+            v.x += v.dx * dt;
+            v.y += v.dy * dt;
+        }
+        t += dt;
+    }
+    
+    printf("No collision within %.1fs\n", max_time);
+    return -1;
+}
+
+/**
+ * Contact reported by the event-driven simulator
+ */
+struct ContactEvent {
+    double time;  // Time of first contact (seconds)
+    int a, b;     // Vehicle ids, a < b
+};
+
+/**
+ * Event-driven kinematic simulator
+ * 
+ * Each vehicle's state is stored at its own reference time t_ref[i]
+ * (position at t = x + dx * (t - t_ref)), so vehicles are only touched when
+ * an event involves them.
+ */
+class EventDrivenSimulator {
+private:
+    struct Event {
+        double time;
+        int a, b;              // Vehicle indices; b = -1 for a maneuver
+        unsigned va, vb;       // Versions of a and b when predicted
+        double new_dx, new_dy; // Maneuver only: velocity from this time on
+    };
+    
+    // Orders the priority queue so the earliest event is on top
+    struct Later {
+        bool operator()(const Event& x, const Event& y) const {
+            return x.time > y.time;
+        }
+    };
+    
+    vector<Vehicle> vehicles;
+    vector<double> t_ref;
+    vector<unsigned> version;
+    priority_queue<Event, vector<Event>, Later> events;
+    double now = 0;
+    
+    // State of vehicle i extrapolated to time t
+    Vehicle at(int i, double t) const {
+        Vehicle v = vehicles[i];
+        v.x += v.dx * (t - t_ref[i]);
+        v.y += v.dy * (t - t_ref[i]);
+        return v;
+    }
+    
+    // Predict the next contact of pair (i, j) from the current time
+    // Pairs already touching only produce an event at the very start
+    void predict(int i, int j) {
+        double t = timeOfImpact(at(i, now), at(j, now));
+        if (t < 0 || (t == 0 && now > 0)) return;
+        events.push(Event{now + t, i, j, version[i], version[j], 0, 0});
+    }
+
+public:
+    /**
+     * Seed the queue with the first predicted contact of every pair
+     * 
+     * @param initial Vehicles at t=0
+     */
+    explicit EventDrivenSimulator(const vector<Vehicle>& initial)
+        : vehicles(initial), t_ref(initial.size(), 0.0), version(initial.size(), 0) {
+        for (size_t i = 0; i < vehicles.size(); i++) {
+            for (size_t j = i + 1; j < vehicles.size(); j++) {
+                predict(i, j);
+            }
+        }
+    }
+    
+    /**
+     * Change a vehicle's velocity at a given time
+     * 
+     * @param index Vehicle index in the initial list
+     * @param time When the new velocity takes effect (seconds)
+     * @param dx, dy New velocity components
+     */
+    void scheduleManeuver(int index, double time, double dx, double dy) {
+        events.push(Event{time, index, -1, 0, 0, dx, dy});
+    }
+    
+    /**
+     * Advance from event to event until max_time
+     * 
+     * @param max_time Simulation horizon (seconds)
+     * @param stop_at_first Return as soon as the first contact is found
+     * @return Contacts in time order
+     */
+    vector<ContactEvent> run(double max_time, bool stop_at_first = true) {
+        vector<ContactEvent> contacts;
+        
+        while (!events.empty() && events.top().time <= max_time) {
+            Event e = events.top();
+            events.pop();
+            
+            if (e.b == -1) {
+                // Maneuver: move the vehicle to now, change velocity,
+                // invalidate its old predictions and predict again
+                now = e.time;
+                vehicles[e.a] = at(e.a, now);
+                t_ref[e.a] = now;
+                vehicles[e.a].dx = e.new_dx;
+                vehicles[e.a].dy = e.new_dy;
+                version[e.a]++;
+                for (int j = 0; j < (int)vehicles.size(); j++) {
+                    if (j != e.a) predict(e.a, j);
+                }
+                continue;
+            }
+            
+            // Lazy invalidation: one of the vehicles changed since prediction
+            if (e.va != version[e.a] || e.vb != version[e.b]) continue;
+            
+            now = e.time;
+            contacts.push_back(ContactEvent{e.time, 
+                min(vehicles[e.a].id, vehicles[e.b].id), 
+                max(vehicles[e.a].id, vehicles[e.b].id)});
+            if (stop_at_first) break;
+        }
+        
+        return contacts;
+    }
+};
+
+/**
+ * One collision found by findAllCollisions
+ */
+struct CollisionRecord {
+    double time;  // Step time at which the contact was first seen
+    int a, b;     // Vehicle ids, a < b
+    double x, y;  // Contact point: on the center line, ra from a's center
+};
+
+/**
+ * Find every collision over the horizon with a stepped, multi-threaded check
+ * 
+ * @param vehicles Vehicles at t=0 (not modified)
+ * @param dt Timestep duration (seconds)
+ * @param max_time Maximum simulation time (seconds)
+ * @param num_threads Worker threads for the per-step pair checks
+ * @return Collisions ordered by time, then by vehicle ids
+ */
+vector<CollisionRecord> findAllCollisions(const vector<Vehicle>& vehicles, double dt, double max_time,
+                                          unsigned num_threads = thread::hardware_concurrency()) {
+    size_t n = vehicles.size();
+    num_threads = max(1u, num_threads);
+    vector<CollisionRecord> result;
+    if (n < 2) return result;
+    
+    // Grid cell: two circles that touch lie in the same or adjacent cells
+    double max_r = 0;
+    for (const auto& v : vehicles) max_r = max(max_r, v.r);
+    double cell = max(2 * max_r, 1e-9);
+    
+    vector<Vehicle> now(vehicles);          // Positions at the current step
+    vector<pair<uint64_t, int>> by_cell(n); // (cell key, vehicle index), sorted
+    vector<vector<pair<int, int>>> hits(num_threads);
+    vector<pair<int, int>> touching, was_touching;  // Sorted pairs in contact
+    
+    auto cellKey = [](int64_t cx, int64_t cy) {
+        return ((uint64_t)(cx + (1LL << 31)) << 32) | (uint64_t)(cy + (1LL << 31));
+    };
+    
+    for (int step = 0; step * dt < max_time; step++) {
+        double t = step * dt;
+        
+        // Step 1: Positions at t and grid bucketing
+        for (size_t i = 0; i < n; i++) {
+            now[i].x = vehicles[i].x + vehicles[i].dx * t;
+            now[i].y = vehicles[i].y + vehicles[i].dy * t;
+            by_cell[i] = {cellKey((int64_t)floor(now[i].x / cell), 
+                                  (int64_t)floor(now[i].y / cell)), (int)i};
+        }
+        sort(by_cell.begin(), by_cell.end());
+        
+        // Start of every occupied cell in by_cell (plus an end marker)
+        vector<size_t> cell_start;
+        for (size_t i = 0; i < n; i++) {
+            if (i == 0 || by_cell[i].first != by_cell[i - 1].first) cell_start.push_back(i);
+        }
+        cell_start.push_back(n);
+        size_t cells = cell_start.size() - 1;
+        
+        // Step 2: Each thread checks a contiguous range of cells
+        auto worker = [&](unsigned tid) {
+            auto& out = hits[tid];
+            out.clear();
+            
+            auto testPair = [&](int i, int j) {
+                if (collides(now[i], now[j])) out.push_back({min(i, j), max(i, j)});
+            };
+            
+            for (size_t c = cells * tid / num_threads; c < cells * (tid + 1) / num_threads; c++) {
+                size_t begin = cell_start[c], end = cell_start[c + 1];
+                
+                // Pairs inside the cell
+                for (size_t p = begin; p < end; p++) {
+                    for (size_t q = p + 1; q < end; q++) {
+                        testPair(by_cell[p].second, by_cell[q].second);
+                    }
+                }
+                
+                // Pairs with forward neighbours (each neighbouring pair once)
+                int64_t cx = (int64_t)(by_cell[begin].first >> 32) - (1LL << 31);
+                int64_t cy = (int64_t)(by_cell[begin].first & 0xffffffffULL) - (1LL << 31);
+                const int64_t offsets[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}};
+                for (const auto& off : offsets) {
+                    uint64_t key = cellKey(cx + off[0], cy + off[1]);
+                    auto it = lower_bound(by_cell.begin(), by_cell.end(), make_pair(key, -1));
+                    for (; it != by_cell.end() && it->first == key; ++it) {
+                        for (size_t p = begin; p < end; p++) {
+                            testPair(by_cell[p].second, it->second);
+                        }
+                    }
+                }
+            }
+        };
+        
+        vector<thread> pool;
+        for (unsigned tid = 1; tid < num_threads; tid++) pool.emplace_back(worker, tid);
+        worker(0);
+        for (auto& th : pool) th.join();
+        
+        // Step 3: Deterministic merge of the per-thread buffers
+        touching.clear();
+        for (const auto& h : hits) touching.insert(touching.end(), h.begin(), h.end());
+        sort(touching.begin(), touching.end());
+        
+        // Step 4: Report pairs that were not already touching last step
+        vector<CollisionRecord> step_hits;
+        for (const auto& [i, j] : touching) {
+            if (binary_search(was_touching.begin(), was_touching.end(), make_pair(i, j))) continue;
+            
+            // a is the lower id: the contact point is measured from its center
+            const Vehicle& a = (now[i].id < now[j].id) ? now[i] : now[j];
+            const Vehicle& b = (now[i].id < now[j].id) ? now[j] : now[i];
+            double dist = sqrt((b.x - a.x) * (b.x - a.x) + (b.y - a.y) * (b.y - a.y));
+            double f = (dist > 0) ? min(1.0, a.r / dist) : 0.0;
+            step_hits.push_back({t, a.id, b.id, a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f});
+        }
+        sort(step_hits.begin(), step_hits.end(), [](const CollisionRecord& p, const CollisionRecord& q) {
+            return p.a != q.a ? p.a < q.a : p.b < q.b;
+        });
+        result.insert(result.end(), step_hits.begin(), step_hits.end());
+        swap(touching, was_touching);
+    }
+    
+    return result;
+}
+
+/**
+ * Structure-of-arrays vehicle storage
+ */
+struct VehicleStore {
+    vector<int> id;
+    vector<double> x, y;    // Positions
+    vector<double> dx, dy;  // Velocities
+    vector<double> r;       // Collision radii
+    
+    explicit VehicleStore(const vector<Vehicle>& vehicles) {
+        for (const auto& v : vehicles) {
+            id.push_back(v.id);
+            x.push_back(v.x);
+            y.push_back(v.y);
+            dx.push_back(v.dx);
+            dy.push_back(v.dy);
+            r.push_back(v.r);
+        }
+    }
+    
+    size_t size() const { return id.size(); }
+    
+    /**
+     * Advance every position by velocity * dt
+     */
+    void integrate(double dt) {
+        size_t n = size();
+        size_t i = 0;
+#ifdef __AVX2__
+        __m256d step = _mm256_set1_pd(dt);
+        for (; i + 4 <= n; i += 4) {
+            __m256d px = _mm256_loadu_pd(&x[i]);
+            __m256d py = _mm256_loadu_pd(&y[i]);
+            px = _mm256_add_pd(px, _mm256_mul_pd(_mm256_loadu_pd(&dx[i]), step));
+            py = _mm256_add_pd(py, _mm256_mul_pd(_mm256_loadu_pd(&dy[i]), step));
+            _mm256_storeu_pd(&x[i], px);
+            _mm256_storeu_pd(&y[i], py);
+        }
+#endif
+        for (; i < n; i++) {
+            x[i] += dx[i] * dt;
+            y[i] += dy[i] * dt;
+        }
+    }
+    
+    /**
+     * First vehicle j in [from, size()) overlapping vehicle i
+     * 
+     * @return Index j, or -1 if none overlaps
+     */
+    int firstOverlap(size_t i, size_t from) const {
+        size_t n = size();
+        size_t j = from;
+#ifdef __AVX2__
+        __m256d xa = _mm256_set1_pd(x[i]);
+        __m256d ya = _mm256_set1_pd(y[i]);
+        __m256d ra = _mm256_set1_pd(r[i]);
+        for (; j + 4 <= n; j += 4) {
+            __m256d ddx = _mm256_sub_pd(_mm256_loadu_pd(&x[j]), xa);
+            __m256d ddy = _mm256_sub_pd(_mm256_loadu_pd(&y[j]), ya);
+            __m256d rr = _mm256_add_pd(_mm256_loadu_pd(&r[j]), ra);
+            __m256d d2 = _mm256_add_pd(_mm256_mul_pd(ddx, ddx), _mm256_mul_pd(ddy, ddy));
+            
+            // One bit per lane that overlaps; lowest set bit = first in order
+            int mask = _mm256_movemask_pd(_mm256_cmp_pd(d2, _mm256_mul_pd(rr, rr), _CMP_LE_OQ));
+            if (mask) return j + __builtin_ctz(mask);
+        }
+#endif
+        for (; j < n; j++) {
+            double ddx = x[j] - x[i], ddy = y[j] - y[i], rr = r[i] + r[j];
+            if (ddx * ddx + ddy * ddy <= rr * rr) return j;
+        }
+        return -1;
+    }
+};
+
+/**
+ * Same simulation as findFirstCollision on SoA storage with SIMD kernels
+ * 
+ * @param store Vehicles to simulate (modified in-place)
+ * @param dt Timestep duration (seconds)
+ * @param max_time Maximum simulation time (seconds)
+ * @return Time of first collision, or -1 if no collision occurs
+ */
+double findFirstCollisionSoA(VehicleStore& store, double dt, double max_time) {
+    double t = 0;
+    
+    while (t < max_time) {
+        for (size_t i = 0; i < store.size(); i++) {
+            int j = store.firstOverlap(i, i + 1);
+            if (j >= 0) {
+                printf("Collision at t=%.2f between vehicles %d and %d\n", 
+                       t, store.id[i], store.id[j]);
+                return t;
+            }
+        }
+        store.integrate(dt);
+        t += dt;
+    }
+    
+    printf("No collision within %.1fs\n", max_time);
+    return -1;
+}
+
+/**
+ * Vehicle with an oriented convex footprint
+ * 
+ * hull holds the vertices in the vehicle frame (counter-clockwise, center at
+ * the origin, x along heading). An empty hull means a plain circle of radius
+ * body.r. For polygons, body.r is the bounding radius used for rejection.
+ */
+struct ShapedVehicle {
+    Vehicle body;
+    double heading;                     // Radians, counter-clockwise from +x
+    vector<pair<double, double>> hull;  // Local-frame vertices
+};
+
+/**
+ * Convex polygon vehicle; body.r is set to the farthest vertex distance
+ */
+ShapedVehicle makePolygonVehicle(int id, double x, double y, double dx, double dy,
+                                 double heading, const vector<pair<double, double>>& vertices) {
+    double bound = 0;
+    for (const auto& [vx, vy] : vertices) bound = max(bound, sqrt(vx*vx + vy*vy));
+    return ShapedVehicle{{id, x, y, dx, dy, bound}, heading, vertices};
+}
+
+/**
+ * Oriented rectangle vehicle (length along heading, width across it)
+ */
+ShapedVehicle makeBoxVehicle(int id, double x, double y, double dx, double dy,
+                             double heading, double length, double width) {
+    double hl = length / 2, hw = width / 2;
+    return makePolygonVehicle(id, x, y, dx, dy, heading, 
+                              {{-hl, -hw}, {hl, -hw}, {hl, hw}, {-hl, hw}});
+}
+
+/**
+ * Hull vertices of a shaped vehicle in world coordinates
+ */
+vector<pair<double, double>> worldHull(const ShapedVehicle& v) {
+    double c = cos(v.heading), s = sin(v.heading);
+    vector<pair<double, double>> world;
+    for (const auto& [lx, ly] : v.hull) {
+        world.push_back({v.body.x + c*lx - s*ly, v.body.y + s*lx + c*ly});
+    }
+    return world;
+}
+
+/**
+ * Projection interval of a shape onto axis (ax, ay)
+ */
+pair<double, double> projectShape(const ShapedVehicle& v, const vector<pair<double, double>>& world,
+                                  double ax, double ay) {
+    if (world.empty()) {
+        // Circle: center projection +- radius (scaled by axis length)
+        double center = v.body.x*ax + v.body.y*ay;
+        double extent = v.body.r * sqrt(ax*ax + ay*ay);
+        return {center - extent, center + extent};
+    }
+    double lo = world[0].first*ax + world[0].second*ay, hi = lo;
+    for (const auto& [px, py] : world) {
+        double p = px*ax + py*ay;
+        lo = min(lo, p);
+        hi = max(hi, p);
+    }
+    return {lo, hi};
+}
+
+/**
+ * Check if two shaped vehicles overlap
+ * 
+ * Bounding circles reject most pairs; SAT decides the rest
+ * 
+ * @return true if the footprints touch or overlap
+ */
+bool collidesShaped(const ShapedVehicle& a, const ShapedVehicle& b) {
+    // Cheap rejection on bounding circles
+    if (!collides(a.body, b.body)) return false;
+    if (a.hull.empty() && b.hull.empty()) return true;  // Both circles: exact already
+    
+    vector<pair<double, double>> wa = worldHull(a), wb = worldHull(b);
+    
+    // Candidate separating axes: edge normals of both polygons
+    vector<pair<double, double>> axes;
+    for (const auto* w : {&wa, &wb}) {
+        for (size_t i = 0; i < w->size(); i++) {
+            const auto& p = (*w)[i];
+            const auto& q = (*w)[(i + 1) % w->size()];
+            axes.push_back({-(q.second - p.second), q.first - p.first});
+        }
+    }
+    
+    // Circle vs polygon: also the axis from the circle center to the nearest vertex
+    if (a.hull.empty() || b.hull.empty()) {
+        const ShapedVehicle& circle = a.hull.empty() ? a : b;
+        const auto& poly = a.hull.empty() ? wb : wa;
+        double best = -1, bx = 0, by = 0;
+        for (const auto& [px, py] : poly) {
+            double ddx = px - circle.body.x, ddy = py - circle.body.y;
+            double d2 = ddx*ddx + ddy*ddy;
+            if (best < 0 || d2 < best) { best = d2; bx = ddx; by = ddy; }
+        }
+        axes.push_back({bx, by});
+    }
+    
+    for (const auto& [ax, ay] : axes) {
+        if (ax == 0 && ay == 0) continue;
+        auto pa = projectShape(a, wa, ax, ay);
+        auto pb = projectShape(b, wb, ax, ay);
+        if (pa.second < pb.first || pb.second < pa.first) return false;  // Separated
+    }
+    return true;
+}
+
+/**
+ * Same simulation as findFirstCollision with shaped footprints
+ * 
+ * Vehicles translate with constant velocity; headings stay fixed
+ * 
+ * @param vehicles List of shaped vehicles to simulate (modified in-place)
+ * @param dt Timestep duration (seconds)
+ * @param max_time Maximum simulation time (seconds)
+ * @return Time of first collision, or -1 if no collision occurs
+ */
+double findFirstCollisionShaped(vector<ShapedVehicle>& vehicles, double dt, double max_time) {
+    double t = 0;
+    
+    while (t < max_time) {
+        for (size_t i = 0; i < vehicles.size(); i++) {
+            for (size_t j = i + 1; j < vehicles.size(); j++) {
+                if (collidesShaped(vehicles[i], vehicles[j])) {
+                    printf("Collision at t=%.2f between vehicles %d and %d\n", 
+                           t, vehicles[i].body.id, vehicles[j].body.id);
+                    return t;
+                }
+            }
+        }
+        
+        for (auto& v : vehicles) {
+            v.body.x += v.body.dx * dt;
+            v.body.y += v.body.dy * dt;
+        }
+        t += dt;
+    }
+    
+    printf("No collision within %.1fs\n", max_time);
+    return -1;
+}
+
 /**
  * Test cases demonstrating the collision detection
  */
@@ -137,6 +882,9 @@ int main() {
         {1, 0.0, 0.0, 1.0, 0.0, r},   // Vehicle 1: at origin, moving right (dx=1.0)
         {2, 5.0, 0.0, -1.0, 0.0, r}   // Vehicle 2: at x=5, moving left (dx=-1.0)
     };
+    printf("Exact:   ");
+    findFirstCollisionExact(v1, 10.0);   // Before stepping: stepping moves the vehicles
+    printf("Stepped: ");
     findFirstCollision(v1, dt, 10.0);
     
     // Test 2: T-bone collision
@@ -147,6 +895,9 @@ int main() {
         {1, 0.0, 0.0, 2.0, 0.0, r},   // Vehicle 1: moving right at 2.0 units/s
         {2, 3.0, -3.0, 0.0, 2.0, r}   // Vehicle 2: moving up at 2.0 units/s
     };
+    printf("Exact:   ");
+    findFirstCollisionExact(v2, 10.0);   // Before stepping: stepping moves the vehicles
+    printf("Stepped: ");
     findFirstCollision(v2, dt, 10.0);
     
     // Test 3: Near miss - no collision
@@ -157,8 +908,127 @@ int main() {
         {1, 0.0, 0.0, 1.0, 0.0, r},   // Vehicle 1: at y=0, moving right
         {2, 5.0, 2.0, -1.0, 0.0, r}   // Vehicle 2: at y=2, moving left (offset by 2 units)
     };
+    printf("Exact:   ");
+    findFirstCollisionExact(v3, 10.0);   // Before stepping: stepping moves the vehicles
+    printf("Stepped: ");
     findFirstCollision(v3, dt, 10.0);
     
+    // Test 4: Tunneling - fast vehicles pass through each other within one step
+    printf("\nTest 4: Fast head-on (tunneling)\n");
+    printf("---------------------------\n");
+    vector<Vehicle> v4 = {
+        {1, 0.0, 0.0, 40.0, 0.0, r},   // Vehicle 1: moving right at 40 units/s
+        {2, 5.0, 0.0, -40.0, 0.0, r}   // Vehicle 2: moving left at 40 units/s
+    };
+    printf("Exact:   ");
+    findFirstCollisionExact(v4, 10.0);   // Expected: t=0.05
+    printf("Stepped: ");
+    findFirstCollision(v4, dt, 10.0);    // Misses it: gap jumps from 5 to -3 in one step
+    
+    // Test 5: Event-driven - a maneuver cancels a predicted collision
+    printf("\nTest 5: Event-driven with a swerve\n");
+    printf("---------------------------\n");
+    vector<Vehicle> v5 = {
+        {1, 0.0, 0.0, 1.0, 0.0, r},    // Vehicle 1: moving right
+        {2, 10.0, 0.0, -1.0, 0.0, r},  // Vehicle 2: head-on with 1, contact at t=4.5
+        {3, 8.0, 6.0, 0.0, 0.0, r}     // Vehicle 3: parked above the road
+    };
+    EventDrivenSimulator sim(v5);
+    sim.scheduleManeuver(1, 2.0, 0.0, 1.0);  // At t=2 vehicle 2 swerves up, toward 3
+    for (const auto& c : sim.run(20.0, false)) {
+        printf("Contact at t=%.4f between vehicles %d and %d\n", c.time, c.a, c.b);
+    }
+    printf("(expected: only 2-3 at t=7.0; the 1-2 prediction is stale)\n");
+    
+    // Test 6: Dense traffic - all-pairs vs sweep-and-prune broad phase
+    printf("\nTest 6: 3000 vehicles on a 10km highway\n");
+    printf("---------------------------\n");
+    // 10 lanes 4 units apart, 300 evenly spaced vehicles per lane,
+    // lane speed plus a per-vehicle variation so some catch up with others
+    mt19937 rng(3);
+    uniform_real_distribution<double> variation(-5.0, 5.0);
+    vector<Vehicle> traffic;
+    for (int lane = 0; lane < 10; lane++) {
+        double lane_speed = (lane % 2 == 0) ? 25.0 : -25.0;
+        for (int k = 0; k < 300; k++) {
+            traffic.push_back({lane * 300 + k, k * 33.3, lane * 4.0, 
+                               lane_speed + variation(rng), 0.0, 1.0});
+        }
+    }
+    vector<Vehicle> traffic_sap = traffic;
+    const vector<Vehicle> traffic_start = traffic;   // Stepping moves the others
+    
+    auto t0 = chrono::steady_clock::now();
+    printf("All pairs: ");
+    findFirstCollision(traffic, dt, 10.0);
+    auto t1 = chrono::steady_clock::now();
+    printf("SAP:       ");
+    findFirstCollisionSAP(traffic_sap, dt, 10.0);
+    auto t2 = chrono::steady_clock::now();
+    printf("All pairs: %.1f ms, SAP: %.1f ms\n", 
+           chrono::duration<double, milli>(t1 - t0).count(),
+           chrono::duration<double, milli>(t2 - t1).count());
+    
+    // Test 7: Every collision over the horizon, 1 thread vs 4 threads
+    printf("\nTest 7: All collisions on the highway (10s)\n");
+    printf("---------------------------\n");
+    auto t3 = chrono::steady_clock::now();
+    vector<CollisionRecord> all1 = findAllCollisions(traffic_start, dt, 10.0, 1);
+    auto t4 = chrono::steady_clock::now();
+    vector<CollisionRecord> all4 = findAllCollisions(traffic_start, dt, 10.0, 4);
+    auto t5 = chrono::steady_clock::now();
+    bool same = all1.size() == all4.size();
+    for (size_t i = 0; same && i < all1.size(); i++) {
+        same = all1[i].time == all4[i].time && all1[i].a == all4[i].a && all1[i].b == all4[i].b;
+    }
+    printf("Collisions: %zu, first at t=%.2f between %d and %d (%.1f, %.1f)\n", all1.size(),
+           all1.empty() ? -1.0 : all1[0].time, all1.empty() ? -1 : all1[0].a, 
+           all1.empty() ? -1 : all1[0].b, all1.empty() ? 0.0 : all1[0].x, all1.empty() ? 0.0 : all1[0].y);
+    printf("1 thread: %.1f ms, 4 threads: %.1f ms, identical: %s\n",
+           chrono::duration<double, milli>(t4 - t3).count(),
+           chrono::duration<double, milli>(t5 - t4).count(), same ? "yes" : "NO");
+    
+    // Test 8: AoS all-pairs vs SoA + SIMD all-pairs on the same traffic
+    printf("\nTest 8: AoS vs SoA/SIMD stepping\n");
+    printf("---------------------------\n");
+    vector<Vehicle> traffic_aos = traffic_start;
+    VehicleStore traffic_soa(traffic_start);
+    auto t6 = chrono::steady_clock::now();
+    printf("AoS:      ");
+    findFirstCollision(traffic_aos, dt, 10.0);
+    auto t7 = chrono::steady_clock::now();
+    printf("SoA/SIMD: ");
+    findFirstCollisionSoA(traffic_soa, dt, 10.0);
+    auto t8 = chrono::steady_clock::now();
+    printf("AoS: %.1f ms, SoA/SIMD: %.1f ms\n",
+           chrono::duration<double, milli>(t7 - t6).count(),
+           chrono::duration<double, milli>(t8 - t7).count());
+    
+    // Test 9: Two 16m trucks overtaking in adjacent lanes 3.5 units apart
+    printf("\nTest 9: Trucks in adjacent lanes (circle vs box footprint)\n");
+    printf("---------------------------\n");
+    vector<Vehicle> trucks_circle = {
+        {1, 0.0, 0.0, 20.0, 0.0, 8.0},    // Circle around a 16m truck
+        {2, 30.0, 3.5, 15.0, 0.0, 8.0}
+    };
+    vector<ShapedVehicle> trucks_box = {
+        makeBoxVehicle(1, 0.0, 0.0, 20.0, 0.0, 0.0, 16.0, 2.5),
+        makeBoxVehicle(2, 30.0, 3.5, 15.0, 0.0, 0.0, 16.0, 2.5)
+    };
+    printf("Circle: ");
+    findFirstCollision(trucks_circle, dt, 10.0);        // False positive
+    printf("Box:    ");
+    findFirstCollisionShaped(trucks_box, dt, 10.0);     // Expected: no collision
+    
+    // Test 10: Truck turning across a lane hits a car (box vs circle)
+    printf("\nTest 10: Diagonal truck vs car\n");
+    printf("---------------------------\n");
+    vector<ShapedVehicle> mixed = {
+        makeBoxVehicle(1, 0.0, 0.0, 5.0, 5.0, M_PI / 4, 16.0, 2.5),   // Moving along y = x
+        ShapedVehicle{{2, 20.0, 17.0, 0.0, 0.0, 1.0}, 0.0, {}}   // Parked car 2.1 off the path
+    };
+    findFirstCollisionShaped(mixed, dt, 10.0);          // Expected: t=2.50
+    
     printf("\n========================================\n");
     
     return 0;
@@ -18,6 +18,17 @@ OPTIMIZED APPROACH (Current Implementation):
 - Count unique parents (cluster representatives)
 - Time Complexity: O(n² × α(n)) where α is inverse Ackermann (nearly O(n²))
 - Space Complexity: O(n) for parent and size arrays
+
+DBSCAN MODE (dbscanClustering):
+- Single-linkage chains noisy points into giant clusters: one stray point
+  between two groups is enough to merge them
+- DBSCAN only lets "core" points (>= minPts neighbors within k) link clusters
+- Border points join the cluster of a neighboring core point, but never link
+  two clusters together; everything else is labeled noise
+- Neighbors come from a uniform grid with cell size k, so each point only
+  looks at the 3×3 block of cells around it
+- Time Complexity: O(n × c × α(n)) where c = average points in a 3×3 block
+- Space Complexity: O(n) for grid, labels and disjoint set
 */
 
 #include <iostream>
@@ -25,6 +36,7 @@ OPTIMIZED APPROACH (Current Implementation):
 #include <cmath>
 #include <algorithm>
 #include <unordered_set>
+#include <unordered_map>
 
 // ============================================================================
 // DISJOINT SET (UNION-FIND) DATA STRUCTURE
@@ -194,6 +206,149 @@ WHY UNION-FIND?
 - Better than DFS/BFS for multiple connectivity queries
 */
 
+// ============================================================================
+// GRID NEIGHBOR SEARCH
+// ============================================================================
+
+// Uniform grid bucketing points by cell of side k
+// Any two points within distance k lie in the same or adjacent cells,
+// so a neighbor query only has to scan the 3×3 block around a point
+class PointGrid
+{
+private:
+    std::vector<std::pair<int, int>>& coords;
+    double cellSize;
+    std::unordered_map<unsigned long long, std::vector<int>> cells;  // cell key -> point indices
+
+    long long cellCoord(int v) const {
+        return (long long)std::floor(v / cellSize);
+    }
+
+    // Pack (cx, cy) into one 64-bit key
+    static unsigned long long cellKey(long long cx, long long cy){
+        return ((unsigned long long)cx << 32) ^ (unsigned int)cy;
+    }
+
+public:
+    // Bucket all points into cells
+    // Time: O(n)
+    PointGrid(std::vector<std::pair<int, int>>& pts, double k)
+        : coords(pts), cellSize(k > 0 ? k : 1.0) {
+        for(int i = 0; i < (int)coords.size(); i++){
+            long long cx = cellCoord(coords[i].first);
+            long long cy = cellCoord(coords[i].second);
+            cells[cellKey(cx, cy)].push_back(i);
+        }
+    }
+
+    // Call visit(j) for every point j within distance k of point i (including i)
+    // Time: O(points in the 3×3 block around i)
+    template <typename Visitor>
+    void forEachNeighbor(int i, double k, Visitor visit){
+        long long cx = cellCoord(coords[i].first);
+        long long cy = cellCoord(coords[i].second);
+
+        for(long long ox = -1; ox <= 1; ox++){
+            for(long long oy = -1; oy <= 1; oy++){
+                auto it = cells.find(cellKey(cx + ox, cy + oy));
+                if(it == cells.end())
+                    continue;
+
+                for(int j : it->second){
+                    if(distance(coords[i], coords[j]) <= k){
+                        visit(j);
+                    }
+                }
+            }
+        }
+    }
+};
+
+// ============================================================================
+// DBSCAN CLUSTERING
+// ============================================================================
+
+enum class PointType { CORE, BORDER, NOISE };
+
+struct DbscanResult {
+    std::vector<int> labels;        // labels[i] = cluster id (0..numClusters-1), -1 for noise
+    std::vector<PointType> types;   // core / border / noise per point
+    int numClusters = 0;
+};
+
+// Density-based clustering: core points within distance k are connected,
+// border points attach to one neighboring core point, the rest is noise
+// A point is core if at least minPts points (itself included) lie within k
+// Time: O(n × c × α(n)) where c = average points in a 3×3 grid block
+DbscanResult dbscanClustering(std::vector<std::pair<int, int>>& coords, double k, int minPts){
+    int n = coords.size();
+    DbscanResult result;
+    result.labels.assign(n, -1);
+    result.types.assign(n, PointType::NOISE);
+
+    if(n == 0)
+        return result;
+
+    PointGrid grid(coords, k);
+
+    // Pass 1: count neighbors to find core points
+    for(int i = 0; i < n; i++){
+        int count = 0;
+        grid.forEachNeighbor(i, k, [&](int){ count++; });
+        if(count >= minPts){
+            result.types[i] = PointType::CORE;
+        }
+    }
+
+    // Pass 2: union core points with their core neighbors
+    // Only core-core edges are unioned, so border points can never bridge clusters
+    DisjointSet ds(n);
+    for(int i = 0; i < n; i++){
+        if(result.types[i] != PointType::CORE)
+            continue;
+
+        grid.forEachNeighbor(i, k, [&](int j){
+            if(j > i && result.types[j] == PointType::CORE){
+                ds.Unionfind(i, j);
+            }
+        });
+    }
+
+    // Pass 3: give each core component a dense id
+    std::unordered_map<int, int> clusterId;  // representative -> cluster id
+    for(int i = 0; i < n; i++){
+        if(result.types[i] != PointType::CORE)
+            continue;
+
+        int root = ds.findUpar(i);
+        auto it = clusterId.find(root);
+        if(it == clusterId.end()){
+            it = clusterId.emplace(root, result.numClusters++).first;
+        }
+        result.labels[i] = it->second;
+    }
+
+    // Pass 4: attach non-core points to the first core neighbor found (border)
+    for(int i = 0; i < n; i++){
+        if(result.types[i] == PointType::CORE)
+            continue;
+
+        int coreNeighbor = -1;
+        grid.forEachNeighbor(i, k, [&](int j){
+            if(coreNeighbor == -1 && result.types[j] == PointType::CORE){
+                coreNeighbor = j;
+            }
+        });
+
+        if(coreNeighbor != -1){
+            result.types[i] = PointType::BORDER;
+            result.labels[i] = result.labels[coreNeighbor];
+        }
+    }
+
+    return result;
+}
+
 int main(){
     std::cout << "=== POINT CLUSTERING EXAMPLE ===" << std::endl;
     
@@ -228,6 +383,30 @@ int main(){
     int groups2 = clustering(coords, k2);
     std::cout << "Distance threshold k = " << k2 << std::endl;
     std::cout << "Number of clusters: " << groups2 << " (expected: 4, all separate)" << std::endl;
+
+    // DBSCAN test: two dense groups joined by a sparse chain of points
+    // Single-linkage merges everything; DBSCAN keeps the groups apart
+    std::cout << "\n=== DBSCAN MODE ===" << std::endl;
+    std::vector<std::pair<int, int>> noisy = {
+        {0, 0}, {0, 1}, {1, 0}, {1, 1},       // Dense group A
+        {2, 0}, {3, 0}, {4, 0},               // Sparse chain between groups
+        {5, 0}, {5, 1}, {6, 0}, {6, 1},       // Dense group B
+        {20, 20}                              // Isolated outlier
+    };
+    double k3 = 1.5;
+    int minPts = 4;
+    std::cout << "Single-linkage clusters: " << clustering(noisy, k3)
+              << " (expected: 2, chain merges A and B, plus the outlier)" << std::endl;
+
+    DbscanResult db = dbscanClustering(noisy, k3, minPts);
+    std::cout << "DBSCAN clusters (minPts = " << minPts << "): " << db.numClusters
+              << " (expected: 2, outlier is noise)" << std::endl;
+    for(size_t i = 0; i < noisy.size(); i++){
+        const char* type = db.types[i] == PointType::CORE ? "core"
+                         : db.types[i] == PointType::BORDER ? "border" : "noise";
+        std::cout << "  (" << noisy[i].first << "," << noisy[i].second << ") -> "
+                  << type << ", cluster " << db.labels[i] << std::endl;
+    }
     
     return 0;
 }
\ No newline at end of file
@@ -13,16 +13,57 @@ BRUTE FORCE APPROACH:
 - Space Complexity: O(n·m)
 
 OPTIMIZED APPROACH (Current Implementation):
-- Group segments by their line equation (slope-intercept form)
-- Use hash map for O(1) line lookup
-- Merge segments on same line by collecting unique points
-- Time Complexity: O(n·m·log(m)) due to sorting points
+- Group segments by a canonical line key: direction angle in [0, π) plus
+  signed offset of the line from a reference point (the first lane's start,
+  so map coordinates like UTM don't amplify angle noise), both snapped to a
+  coarse grid
+- Use hash map for O(1) line lookup, probing neighboring grid cells so lines
+  that differ only by floating-point noise still land in the same group; a
+  lane joins a candidate group only if both its endpoints lie within
+  OFFSET_EPS of that group's line (perpendicular distance)
+- Angle/offset form has no vertical special case (vertical is just angle π/2)
+- Merge segments on same line by projecting them to 1D intervals along the
+  line direction, then sort-and-sweep interval union (one piece per run)
+- Time Complexity: O(n + s·log(s)) where s = segments in a line group
 - Space Complexity: O(n·m) for storing grouped segments
+
+POLYLINE MODE (mergeLanePolylines):
+- mergeLanes treats each lane as the straight chord from first to last point
+- For curved HD-map lanes, split each polyline into maximal straight pieces,
+  merge the pieces with mergeLanes, then stitch the merged runs back into
+  continuous polylines through a hash index over quantized endpoints
+- Time Complexity: O(N + s·log(s)) where N = total vertices
+
+PARALLEL MODE (mergeLanesParallel / mergeLanesTiled):
+- Canonical lines and keys are computed in parallel chunks
+- Group ids are assigned in one serial hash pass (cheap, O(n)), then lanes are
+  partitioned by group id with a counting sort into one contiguous array
+- Each group is projected and swept on a worker pool; results are gathered
+  into one preallocated output in the same order as mergeLanes
+- mergeLanesTiled streams a map tile by tile so only one tile is in memory;
+  runs crossing a tile seam come out as separate touching pieces
+
+SPATIAL INDEX (LaneRTree):
+- Packed static R-tree over merged lanes, bulk loaded with Sort-Tile-Recursive
+  (sort by x, cut into vertical slices, sort each slice by y, pack runs of
+  NODE_SIZE) into one contiguous node array, no per-node allocation
+- Nearest-lane: best-first search ordered by box distance, O(log n) typical
+- Box overlap: descend only into overlapping nodes, O(log n + k)
+- Batched queries run across threads with parallelFor
 */
 
 #include <vector>
 #include <algorithm>
 #include <unordered_map>
+#include <utility>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <limits>
+#include <iostream>
+#include <random>
+#include <chrono>
 #include <cmath>
 
 // ============================================================================
@@ -40,49 +81,159 @@ struct Point {
 using Segment = std::vector<Point>;
 
 // ============================================================================
-// LINE REPRESENTATION
+// CANONICAL LINE KEY (used to group segments in unordered_map)
 // ============================================================================
 
-// Represents a line using equation: y = slope*x + intercept
-// Special handling for vertical lines (infinite slope)
-struct Line {
-    double slope;          // m in y = mx + b
-    double intercept;      // b in y = mx + b
-    bool is_vertical;      // true if line is vertical (x = constant)
-    double x_vertical;     // x-coordinate if line is vertical
+// Grouping tolerance: a lane is on a line if both its endpoints lie within
+// OFFSET_EPS of it
+const double OFFSET_EPS = 1e-6;  // distance units
+
+// Hash grid cells for line keys. Keys only pick candidate groups (the
+// endpoint test decides), so cells are coarse enough that rounding noise
+// moves a line by at most one cell; a short lane far from the reference
+// point has an angle noise of ~1e-9 rad, times its distance for the offset
+const double ANGLE_CELL = 1e-7;   // radians
+const double OFFSET_CELL = 1e-4;  // distance units
+
+// Line in normal form: direction angle θ ∈ [0, π) and signed offset
+// offset = distance from the reference point along normal n = (-sin θ, cos θ)
+// Every line (including vertical ones, θ = π/2) has exactly one such form
+// The lane it came from is kept too: endpoint tests and projections are
+// done relative to its start point, never to far-away world coordinates
+struct CanonicalLine {
+    double angle;
+    double offset;
+    double ux, uy;  // Unit direction (cos θ, sin θ)
+    double ax, ay;  // Lane start point (anchor on the line)
+    double bx, by;  // Lane end point
+};
+
+// Canonical line snapped to the tolerance grid
+struct LineKey {
+    long long angle_bucket;
+    long long offset_bucket;
+
+    bool operator==(const LineKey& other) const {
+        return angle_bucket == other.angle_bucket && 
+               offset_bucket == other.offset_bucket;
+    }
+};
+
+struct LineKeyHash {
+    size_t operator()(const LineKey& key) const {
+        // Mix both buckets (splitmix64 finalizer) so nearby keys spread out
+        unsigned long long h = (unsigned long long)key.angle_bucket * 0x9E3779B97F4A7C15ULL;
+        h ^= (unsigned long long)key.offset_bucket + 0x632BE59BD9B4E019ULL + (h << 6) + (h >> 2);
+        h ^= h >> 30; h *= 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 27; h *= 0x94D049BB133111EBULL;
+        h ^= h >> 31;
+        return (size_t)h;
+    }
+};
+
+// Number of angle buckets in [0, π); bucket ANGLE_BUCKETS wraps back to 0
+const long long ANGLE_BUCKETS = std::llround(M_PI / ANGLE_CELL);
+
+// Reference point for line offsets: start of the first valid lane
+// (any point near the data works; all lanes of one call must share it)
+Point referencePoint(const std::vector<Segment>& lanes) {
+    for (const auto& lane : lanes) {
+        if (lane.size() >= 2) 
+            return lane[0];
+    }
+    return Point(0, 0);
+}
+
+// Calculate the canonical line through a segment's start and end points
+// Time: O(1)
+CanonicalLine getCanonicalLine(const Segment& seg, const Point& ref) {
+    double dx = seg.back().x - seg[0].x;
+    double dy = seg.back().y - seg[0].y;
     
-    // Constructor
-    Line(double m, double b, bool v, double x) 
-        : slope(m), intercept(b), is_vertical(v), x_vertical(x) {}
+    // Direction angle folded into [0, π): a line has no orientation
+    double angle = std::atan2(dy, dx);
+    if (angle < 0) angle += M_PI;
+    if (angle >= M_PI) angle -= M_PI;
+    double ux = std::cos(angle);
+    double uy = std::sin(angle);
     
-    // Check if two lines are equal (with small tolerance for floating point)
-    bool operator==(const Line& other) const {
-        // Different types of lines (one vertical, one not) are not equal
-        if (is_vertical != other.is_vertical) 
-            return false;
-        
-        // For vertical lines, compare x-coordinates
-        if (is_vertical) 
-            return std::abs(x_vertical - other.x_vertical) < 1e-9;
-        
-        // For non-vertical lines, compare slope and intercept
-        return std::abs(slope - other.slope) < 1e-9 && 
-               std::abs(intercept - other.intercept) < 1e-9;
+    // Signed distance of the line from the reference point along its normal
+    double offset = -(seg[0].x - ref.x) * uy + (seg[0].y - ref.y) * ux;
+    
+    return CanonicalLine{angle, offset, ux, uy, 
+                         seg[0].x, seg[0].y, seg.back().x, seg.back().y};
+}
+
+// Snap a canonical line to its grid cell
+// Time: O(1)
+LineKey getLineKey(const CanonicalLine& line) {
+    long long a = std::llround(line.angle / ANGLE_CELL);
+    long long o = std::llround(line.offset / OFFSET_CELL);
+    
+    // Angle π is the same direction as 0 with the normal flipped
+    if (a >= ANGLE_BUCKETS) {
+        a -= ANGLE_BUCKETS;
+        o = -o;
     }
-};
+    return LineKey{a, o};
+}
 
-// ============================================================================
-// HASH FUNCTION FOR LINE (needed for unordered_map)
-// ============================================================================
+// Check if lane `b` lies on line `a`: both of b's endpoints within OFFSET_EPS
+// (perpendicular distance, measured from a's anchor so it stays exact at
+// large map coordinates; orientation and wrap-around don't matter)
+// Time: O(1)
+bool sameLine(const CanonicalLine& a, const CanonicalLine& b) {
+    double dist_start = a.ux * (b.ay - a.ay) - a.uy * (b.ax - a.ax);
+    double dist_end = a.ux * (b.by - a.ay) - a.uy * (b.bx - a.ax);
+    return std::abs(dist_start) <= OFFSET_EPS && std::abs(dist_end) <= OFFSET_EPS;
+}
+
+// Assigns canonical lines to groups of equal lines (within tolerance)
+// Each group remembers the canonical line of the lane that created it
+class LineGrouper {
+private:
+    // A coarse cell may hold several distinct lines
+    std::unordered_map<LineKey, std::vector<int>, LineKeyHash> key_to_group;
+    std::vector<CanonicalLine> group_lines;
 
-struct LineHash {
-    size_t operator()(const Line& line) const {
-        // Hash vertical lines by their x-coordinate
-        if (line.is_vertical) {
-            return std::hash<double>()(line.x_vertical);
+public:
+    // Return the group of an existing line within tolerance, or open a new one
+    // Time: O(1) expected
+    int assign(const CanonicalLine& line, const LineKey& key) {
+        // Probe the 3×3 block of neighboring cells: a line within tolerance
+        // may have been snapped into an adjacent cell
+        for (long long da = -1; da <= 1; da++) {
+            for (long long dof = -1; dof <= 1; dof++) {
+                LineKey probe{key.angle_bucket + da, key.offset_bucket + dof};
+                
+                // Wrap angle around [0, π), flipping the offset sign
+                if (probe.angle_bucket < 0) {
+                    probe.angle_bucket += ANGLE_BUCKETS;
+                    probe.offset_bucket = -probe.offset_bucket;
+                } else if (probe.angle_bucket >= ANGLE_BUCKETS) {
+                    probe.angle_bucket -= ANGLE_BUCKETS;
+                    probe.offset_bucket = -probe.offset_bucket;
+                }
+                
+                auto it = key_to_group.find(probe);
+                if (it == key_to_group.end()) 
+                    continue;
+                for (int group : it->second) {
+                    if (sameLine(group_lines[group], line)) 
+                        return group;
+                }
+            }
         }
-        // Hash non-vertical lines by combining slope and intercept
-        return std::hash<double>()(line.slope) ^ std::hash<double>()(line.intercept);
+        
+        // No existing line within tolerance: start a new group
+        int group = group_lines.size();
+        group_lines.push_back(line);
+        key_to_group[key].push_back(group);
+        return group;
+    }
+    
+    const std::vector<CanonicalLine>& lines() const {
+        return group_lines;
     }
 };
 
@@ -90,150 +241,905 @@ struct LineHash {
 // HELPER FUNCTIONS
 // ============================================================================
 
-// Calculate the line equation from a segment's start and end points
-// Returns: Line object representing the segment
+// Segment projected onto its group's line direction u = (cos θ, sin θ)
+// t_lo <= t_hi, with the original endpoints kept alongside
+struct ProjectedInterval {
+    double t_lo, t_hi;
+    Point p_lo, p_hi;
+};
+
+// Project a segment's endpoints onto the line, measured from its anchor
 // Time: O(1)
-Line getLine(const Segment& seg) {
-    double x1 = seg[0].x;        // First point x
-    double y1 = seg[0].y;        // First point y
-    double x2 = seg.back().x;    // Last point x
-    double y2 = seg.back().y;    // Last point y
+ProjectedInterval projectSegment(const Segment& seg, const CanonicalLine& line) {
+    const Point& a = seg[0];
+    const Point& b = seg.back();
+    double ta = (a.x - line.ax) * line.ux + (a.y - line.ay) * line.uy;
+    double tb = (b.x - line.ax) * line.ux + (b.y - line.ay) * line.uy;
     
-    double dx = x2 - x1;  // Change in x
+    if (ta <= tb) 
+        return ProjectedInterval{ta, tb, a, b};
+    return ProjectedInterval{tb, ta, b, a};
+}
+
+// Union projected intervals of one line into disjoint runs
+// Returns: One segment per run, ordered along the line direction
+// Time: O(s·log(s)) where s = number of intervals
+std::vector<Segment> sweepIntervals(std::vector<ProjectedInterval>& intervals) {
+    // Step 1: Sort intervals by start parameter
+    std::sort(intervals.begin(), intervals.end(), 
+        [](const ProjectedInterval& a, const ProjectedInterval& b) {
+            return a.t_lo < b.t_lo;
+        }
+    );
     
-    // Check if line is vertical (no change in x)
-    if (std::abs(dx) < 1e-9) {
-        // Return vertical line at x = x1
-        return Line{0, 0, true, x1};
+    // Step 2: Sweep, extending the current run while intervals overlap
+    std::vector<Segment> result;
+    ProjectedInterval run = intervals[0];
+    for (size_t i = 1; i < intervals.size(); i++) {
+        const ProjectedInterval& cur = intervals[i];
+        
+        // Overlapping or touching (within tolerance): extend the run
+        if (cur.t_lo <= run.t_hi + OFFSET_EPS) {
+            if (cur.t_hi > run.t_hi) {
+                run.t_hi = cur.t_hi;
+                run.p_hi = cur.p_hi;
+            }
+        } 
+        // Gap: close the current run and start a new one
+        else {
+            result.push_back({run.p_lo, run.p_hi});
+            run = cur;
+        }
     }
+    result.push_back({run.p_lo, run.p_hi});
     
-    // Calculate slope: rise over run (change in y / change in x)
-    double slope = (y2 - y1) / dx;
-    
-    // Calculate y-intercept using: b = y - mx
-    double intercept = y1 - slope * x1;
+    return result;
+}
+
+// Merge multiple segments that lie on the same line
+// Each segment becomes a 1D interval [t_lo, t_hi] along the line; after sorting
+// by t_lo, a single sweep unions overlapping/touching intervals into runs
+// Returns: One segment per disjoint run, ordered along the line direction
+// Time: O(s·log(s)) where s = number of segments
+std::vector<Segment> mergeSegments(const std::vector<Segment>& segments, 
+                                   const CanonicalLine& line) {
+    std::vector<ProjectedInterval> intervals;
+    intervals.reserve(segments.size());
+    for (const auto& seg : segments) {
+        intervals.push_back(projectSegment(seg, line));
+    }
     
-    // Return non-vertical line
-    return Line{slope, intercept, false, 0};
+    return sweepIntervals(intervals);
 }
 
-// Check if a point lies on a given segment
-// Returns: true if point is on the line AND within segment bounds
-// Time: O(1)
-bool isPointOnSegment(const Point& p, const Segment& seg, const Line& line) {
-    // Handle vertical lines separately
-    if (line.is_vertical) {
-        // Check if point's x matches the vertical line's x
-        bool on_vertical_line = std::abs(p.x - line.x_vertical) < 1e-9;
-        
-        // Check if point's y is within segment's y-range
-        double min_y = std::min(seg[0].y, seg.back().y);
-        double max_y = std::max(seg[0].y, seg.back().y);
-        bool within_y_bounds = (min_y - 1e-9 <= p.y) && (p.y <= max_y + 1e-9);
+// ============================================================================
+// MAIN FUNCTION: Merge all lanes
+// ============================================================================
+
+// Group lanes by their canonical line and merge overlapping segments
+// Returns: Vector of merged segments (one per disjoint run on each line)
+// Time: O(n + s·log(s)) summed over line groups
+std::vector<Segment> mergeLanes(const std::vector<Segment>& lanes) {
+    // Step 1: Group each lane by its canonical line
+    Point ref = referencePoint(lanes);
+    LineGrouper grouper;
+    std::vector<std::vector<Segment>> groups;
+    for (const auto& lane : lanes) {
+        // Skip invalid segments (need at least 2 points to form a line)
+        if (lane.size() < 2) 
+            continue;
         
-        return on_vertical_line && within_y_bounds;
+        CanonicalLine lane_line = getCanonicalLine(lane, ref);
+        int group = grouper.assign(lane_line, getLineKey(lane_line));
+        if (group == (int)groups.size()) 
+            groups.emplace_back();
+        groups[group].push_back(lane);
+    }
+
+    // Step 2: Merge segments for each unique line
+    std::vector<Segment> result;
+    for (size_t g = 0; g < groups.size(); g++) {
+        // Merge all segments on this line into disjoint runs
+        std::vector<Segment> merged = mergeSegments(groups[g], grouper.lines()[g]);
+        result.insert(result.end(), merged.begin(), merged.end());
+    }
+    
+    return result;
+}
+
+// ============================================================================
+// PARALLEL MERGING
+// ============================================================================
+
+// Run fn(i) for every i in [0, count) on num_threads workers
+// Workers grab blocks of `grain` indices from a shared atomic counter,
+// so uneven work (large line groups) balances itself
+template <typename Fn>
+void parallelFor(size_t count, unsigned num_threads, size_t grain, Fn fn) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        size_t begin;
+        while ((begin = next.fetch_add(grain)) < count) {
+            size_t end = std::min(begin + grain, count);
+            for (size_t i = begin; i < end; i++) {
+                fn(i);
+            }
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < num_threads; t++) {
+        pool.emplace_back(worker);
+    }
+    worker();  // Calling thread works too
+    for (auto& th : pool) {
+        th.join();
+    }
+}
+
+// Parallel version of mergeLanes
+// Returns: Same segments, in the same order, as mergeLanes
+// Time: O((n + s·log(s)) / p + n) where p = number of threads
+std::vector<Segment> mergeLanesParallel(const std::vector<Segment>& lanes, 
+                                        unsigned num_threads = std::thread::hardware_concurrency()) {
+    if (num_threads == 0) 
+        num_threads = 1;
+    size_t n = lanes.size();
+    
+    // Step 1: Canonical line and grid key per lane (parallel)
+    Point ref = referencePoint(lanes);
+    std::vector<CanonicalLine> lines(n);
+    std::vector<LineKey> keys(n);
+    parallelFor(n, num_threads, 4096, [&](size_t i) {
+        if (lanes[i].size() < 2) 
+            return;
+        lines[i] = getCanonicalLine(lanes[i], ref);
+        keys[i] = getLineKey(lines[i]);
+    });
+    
+    // Step 2: Group ids (serial hash pass; neighbor probing needs one shared map)
+    LineGrouper grouper;
+    std::vector<int> group_of(n, -1);
+    for (size_t i = 0; i < n; i++) {
+        if (lanes[i].size() >= 2) 
+            group_of[i] = grouper.assign(lines[i], keys[i]);
     }
+    size_t num_groups = grouper.lines().size();
     
-    // For non-vertical lines:
-    // Calculate expected y-value at point's x using line equation
-    double expected_y = line.slope * p.x + line.intercept;
+    // Step 3: Partition lane indices by group id (counting sort)
+    // group_start[g]..group_start[g+1] is group g's slice of `order`
+    std::vector<size_t> group_start(num_groups + 1, 0);
+    for (size_t i = 0; i < n; i++) {
+        if (group_of[i] != -1) 
+            group_start[group_of[i] + 1]++;
+    }
+    for (size_t g = 0; g < num_groups; g++) {
+        group_start[g + 1] += group_start[g];
+    }
+    std::vector<size_t> order(group_start[num_groups]);
+    std::vector<size_t> fill(group_start.begin(), group_start.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        if (group_of[i] != -1) 
+            order[fill[group_of[i]]++] = i;
+    }
     
-    // Check if point's actual y matches expected y (within tolerance)
-    bool on_line = std::abs(expected_y - p.y) < 1e-9;
-    if (!on_line) 
-        return false;
+    // Step 4: Merge every group on the worker pool
+    std::vector<std::vector<Segment>> group_runs(num_groups);
+    parallelFor(num_groups, num_threads, 1, [&](size_t g) {
+        const CanonicalLine& line = grouper.lines()[g];
+        
+        std::vector<ProjectedInterval> intervals;
+        intervals.reserve(group_start[g + 1] - group_start[g]);
+        for (size_t k = group_start[g]; k < group_start[g + 1]; k++) {
+            intervals.push_back(projectSegment(lanes[order[k]], line));
+        }
+        group_runs[g] = sweepIntervals(intervals);
+    });
     
-    // Check if point's x is within segment's x-range
-    double min_x = std::min(seg[0].x, seg.back().x);
-    double max_x = std::max(seg[0].x, seg.back().x);
-    bool within_x_bounds = (min_x - 1e-9 <= p.x) && (p.x <= max_x + 1e-9);
+    // Step 5: Gather into one preallocated output (prefix sum of run counts)
+    std::vector<size_t> out_start(num_groups + 1, 0);
+    for (size_t g = 0; g < num_groups; g++) {
+        out_start[g + 1] = out_start[g] + group_runs[g].size();
+    }
+    std::vector<Segment> result(out_start[num_groups]);
+    parallelFor(num_groups, num_threads, 64, [&](size_t g) {
+        std::move(group_runs[g].begin(), group_runs[g].end(), 
+                  result.begin() + out_start[g]);
+    });
     
-    return within_x_bounds;
+    return result;
 }
 
-// Merge multiple segments that lie on the same line
-// Returns: Single merged segment containing all relevant points
-// Time: O(n·m·log(m)) where n = number of segments, m = total points
-Segment mergeSegments(const std::vector<Segment>& segments) {
-    // Step 1: Collect all endpoints from all segments
-    std::vector<Point> points;
-    for (const auto& seg : segments) {
-        points.push_back(seg[0]);        // Add first point
-        points.push_back(seg.back());    // Add last point
+// Stream a map through mergeLanesParallel one tile at a time
+// next_tile fills the next tile's lanes and returns false when the map is done;
+// emit receives each tile's merged segments
+// Memory: O(largest tile)
+void mergeLanesTiled(const std::function<bool(std::vector<Segment>&)>& next_tile,
+                     const std::function<void(std::vector<Segment>&&)>& emit,
+                     unsigned num_threads = std::thread::hardware_concurrency()) {
+    std::vector<Segment> tile;
+    while (true) {
+        tile.clear();
+        if (!next_tile(tile)) 
+            break;
+        emit(mergeLanesParallel(tile, num_threads));
     }
+}
+
+// ============================================================================
+// POLYLINE MERGING
+// ============================================================================
+
+// Split a lane polyline into maximal straight pieces (2 points each)
+// A vertex continues the current piece if it lies within OFFSET_EPS of the
+// piece's line and keeps moving forward; otherwise a new piece starts there
+// Time: O(m) where m = points in the lane
+std::vector<Segment> splitIntoStraightPieces(const Segment& lane) {
+    // Drop repeated vertices (zero-length edges have no direction)
+    Segment pts;
+    for (const auto& p : lane) {
+        if (pts.empty() || 
+            std::hypot(p.x - pts.back().x, p.y - pts.back().y) > OFFSET_EPS) {
+            pts.push_back(p);
+        }
+    }
+    
+    std::vector<Segment> pieces;
+    if (pts.size() < 2) 
+        return pieces;
     
-    // Step 2: Sort points by x-coordinate (then by y if x is same)
-    std::sort(points.begin(), points.end(), 
-        [](const Point& a, const Point& b) {
-            // If x-coordinates are equal, compare y-coordinates
-            if (a.x == b.x) 
-                return a.y < b.y;
-            // Otherwise compare x-coordinates
-            return a.x < b.x;
+    size_t start = 0;
+    for (size_t i = 2; i < pts.size(); i++) {
+        const Point& a = pts[start];
+        const Point& b = pts[i - 1];
+        const Point& c = pts[i];
+        
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double len = std::hypot(dx, dy);
+        
+        // Perpendicular distance of c from line a→b, and progress along it
+        double dist = std::abs(dx * (c.y - a.y) - dy * (c.x - a.x)) / len;
+        double along = dx * (c.x - b.x) + dy * (c.y - b.y);
+        
+        // Direction change: close the piece at b
+        if (dist > OFFSET_EPS || along <= 0) {
+            pieces.push_back({a, b});
+            start = i - 1;
         }
-    );
+    }
+    pieces.push_back({pts[start], pts.back()});
     
-    // Step 3: Remove duplicate points
-    points.erase(
-        std::unique(points.begin(), points.end(), 
-            [](const Point& a, const Point& b) {
-                // Two points are duplicates if both x and y are very close
-                return std::abs(a.x - b.x) < 1e-9 && 
-                       std::abs(a.y - b.y) < 1e-9;
-            }
-        ), 
-        points.end()
-    );
+    return pieces;
+}
 
-    // Step 4: Build merged segment from points that lie on any input segment
-    Segment result;
-    for (const auto& p : points) {
-        // Check if this point lies on at least one of the original segments
-        for (const auto& seg : segments) {
-            if (isPointOnSegment(p, seg, getLine(seg))) {
-                result.push_back(p);
-                break;  // Found one segment containing this point, that's enough
+// Endpoint snapped to an OFFSET_EPS grid, used to find shared vertices
+struct PointKey {
+    long long x, y;
+    
+    bool operator==(const PointKey& other) const {
+        return x == other.x && y == other.y;
+    }
+};
+
+struct PointKeyHash {
+    size_t operator()(const PointKey& key) const {
+        // Same mixing as LineKeyHash
+        return LineKeyHash()(LineKey{key.x, key.y});
+    }
+};
+
+// Stitch merged straight runs back into continuous polylines
+// Runs are edges of an undirected graph whose nodes are shared endpoints;
+// chains through degree-2 nodes become one polyline, branch points
+// (lane splits/merges) and dead ends terminate a polyline
+// Time: O(r) expected where r = number of runs
+std::vector<Segment> stitchRuns(const std::vector<Segment>& runs) {
+    // Step 1: Endpoint hash index (probe 3×3 cells to absorb snapping noise)
+    std::unordered_map<PointKey, int, PointKeyHash> key_to_node;
+    std::vector<Point> nodes;
+    
+    auto getNode = [&](const Point& p) {
+        PointKey key{std::llround(p.x / OFFSET_EPS), std::llround(p.y / OFFSET_EPS)};
+        for (long long dx = -1; dx <= 1; dx++) {
+            for (long long dy = -1; dy <= 1; dy++) {
+                auto it = key_to_node.find(PointKey{key.x + dx, key.y + dy});
+                if (it != key_to_node.end()) 
+                    return it->second;
+            }
+        }
+        int id = nodes.size();
+        nodes.push_back(p);
+        key_to_node.emplace(key, id);
+        return id;
+    };
+    
+    // Step 2: Build adjacency (node -> incident run indices)
+    std::vector<std::pair<int, int>> edges;  // run index -> (node u, node v)
+    edges.reserve(runs.size());
+    for (const auto& run : runs) {
+        edges.emplace_back(getNode(run[0]), getNode(run.back()));
+    }
+    
+    std::vector<std::vector<int>> adjacency(nodes.size());
+    for (int e = 0; e < (int)edges.size(); e++) {
+        adjacency[edges[e].first].push_back(e);
+        adjacency[edges[e].second].push_back(e);
+    }
+    
+    // Step 3: Walk chains, starting from nodes that end a polyline
+    std::vector<bool> used(edges.size(), false);
+    std::vector<Segment> result;
+    
+    auto walk = [&](int start_node, int first_edge) {
+        Segment polyline = {nodes[start_node]};
+        int node = start_node;
+        int edge = first_edge;
+        
+        while (edge != -1) {
+            used[edge] = true;
+            node = (edges[edge].first == node) ? edges[edge].second : edges[edge].first;
+            polyline.push_back(nodes[node]);
+            
+            // Continue only through interior (degree-2) nodes
+            edge = -1;
+            if (adjacency[node].size() == 2) {
+                for (int next : adjacency[node]) {
+                    if (!used[next]) 
+                        edge = next;
+                }
             }
         }
+        result.push_back(polyline);
+    };
+    
+    for (int node = 0; node < (int)nodes.size(); node++) {
+        if (adjacency[node].size() == 2) 
+            continue;
+        for (int e : adjacency[node]) {
+            if (!used[e]) 
+                walk(node, e);
+        }
+    }
+    
+    // Step 4: Whatever is left forms closed loops (all nodes degree 2)
+    for (int e = 0; e < (int)edges.size(); e++) {
+        if (!used[e]) 
+            walk(edges[e].first, e);
     }
     
     return result;
 }
 
+// Merge full lane polylines, keeping interior geometry
+// Returns: Continuous polylines covering the union of all input lanes
+// Time: O(N + s·log(s)) where N = total vertices
+std::vector<Segment> mergeLanePolylines(const std::vector<Segment>& lanes) {
+    // Step 1: Break every lane into straight pieces
+    std::vector<Segment> pieces;
+    for (const auto& lane : lanes) {
+        std::vector<Segment> lane_pieces = splitIntoStraightPieces(lane);
+        pieces.insert(pieces.end(), lane_pieces.begin(), lane_pieces.end());
+    }
+    
+    // Step 2: Merge overlapping collinear pieces
+    std::vector<Segment> runs = mergeLanes(pieces);
+    
+    // Step 3: Stitch merged runs back into polylines
+    return stitchRuns(runs);
+}
+
 // ============================================================================
-// MAIN FUNCTION: Merge all lanes
+// SPATIAL INDEX: PACKED STR R-TREE
 // ============================================================================
 
-// Group lanes by their line equation and merge overlapping segments
-// Returns: Vector of merged segments (one per unique line)
-// Time: O(n·m·log(m))
-std::vector<Segment> mergeLanes(const std::vector<Segment>& lanes) {
-    // Step 1: Create a hash map to group segments by their line
-    // Key = Line equation, Value = all segments on that line
-    std::unordered_map<Line, std::vector<Segment>, LineHash> line_groups;
+// Axis-aligned bounding box
+struct Box {
+    double min_x, min_y, max_x, max_y;
     
-    // Step 2: Group each lane by its line equation
-    for (const auto& lane : lanes) {
-        // Skip invalid segments (need at least 2 points to form a line)
-        if (lane.size() < 2) 
-            continue;
+    // Empty box (expands to fit whatever is added)
+    static Box empty() {
+        double inf = std::numeric_limits<double>::infinity();
+        return Box{inf, inf, -inf, -inf};
+    }
+    
+    void expand(const Box& b) {
+        min_x = std::min(min_x, b.min_x);
+        min_y = std::min(min_y, b.min_y);
+        max_x = std::max(max_x, b.max_x);
+        max_y = std::max(max_y, b.max_y);
+    }
+    
+    bool overlaps(const Box& b) const {
+        return min_x <= b.max_x && b.min_x <= max_x && 
+               min_y <= b.max_y && b.min_y <= max_y;
+    }
+    
+    // Squared distance from p to the nearest point of the box (0 if inside)
+    double distSq(const Point& p) const {
+        double dx = std::max({min_x - p.x, 0.0, p.x - max_x});
+        double dy = std::max({min_y - p.y, 0.0, p.y - max_y});
+        return dx * dx + dy * dy;
+    }
+    
+    double centerX() const { return (min_x + max_x) / 2; }
+    double centerY() const { return (min_y + max_y) / 2; }
+};
+
+// Bounding box of a lane polyline
+// Time: O(m)
+Box laneBox(const Segment& lane) {
+    Box b = Box::empty();
+    for (const auto& p : lane) {
+        b.expand(Box{p.x, p.y, p.x, p.y});
+    }
+    return b;
+}
+
+// Squared distance from p to segment [a, b]
+// Time: O(1)
+double pointSegmentDistSq(const Point& p, const Point& a, const Point& b) {
+    double dx = b.x - a.x, dy = b.y - a.y;
+    double len_sq = dx * dx + dy * dy;
+    
+    // Clamp projection of p onto the segment to [0, 1]
+    double t = 0;
+    if (len_sq > 0) 
+        t = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / len_sq, 0.0, 1.0);
+    
+    double ex = a.x + t * dx - p.x;
+    double ey = a.y + t * dy - p.y;
+    return ex * ex + ey * ey;
+}
+
+// Squared distance from p to a lane polyline
+// Time: O(m)
+double pointLaneDistSq(const Point& p, const Segment& lane) {
+    double best = pointSegmentDistSq(p, lane[0], lane[0]);
+    for (size_t i = 1; i < lane.size(); i++) {
+        best = std::min(best, pointSegmentDistSq(p, lane[i - 1], lane[i]));
+    }
+    return best;
+}
+
+// Check if segment [a, b] touches a box (Liang-Barsky clipping)
+// Time: O(1)
+bool segmentOverlapsBox(const Point& a, const Point& b, const Box& box) {
+    double t0 = 0, t1 = 1;
+    double dx = b.x - a.x, dy = b.y - a.y;
+    
+    // Each (p, q) pair is one box side: inside when p·t <= q
+    double p[4] = {-dx, dx, -dy, dy};
+    double q[4] = {a.x - box.min_x, box.max_x - a.x, a.y - box.min_y, box.max_y - a.y};
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0) {
+            if (q[i] < 0) return false;  // Parallel and outside this side
+        } else {
+            double t = q[i] / p[i];
+            if (p[i] < 0) t0 = std::max(t0, t);
+            else          t1 = std::min(t1, t);
+            if (t0 > t1) return false;
+        }
+    }
+    return true;
+}
+
+// Result of a nearest-lane query
+struct NearestLane {
+    int lane;        // Index into the indexed lanes, -1 if the index is empty
+    double distance;
+};
+
+class LaneRTree {
+private:
+    static const int NODE_SIZE = 16;  // Max children per node
+    
+    // Children of a node are a contiguous range: node indices for inner
+    // nodes, positions in `items` for leaves
+    struct Node {
+        Box box;
+        int first;
+        int count;
+        bool leaf;
+    };
+    
+    const std::vector<Segment>& lanes;
+    std::vector<Box> lane_boxes;
+    std::vector<int> items;   // Lane indices in leaf order
+    std::vector<Node> nodes;  // All levels, bottom-up; root is nodes.back()
+    
+    // Sort-Tile-Recursive ordering of `entries` (by their box centers):
+    // ceil(sqrt(P)) vertical slices of whole pages, each slice sorted by y
+    template <typename GetBox>
+    static void strOrder(std::vector<int>& entries, GetBox get_box) {
+        size_t n = entries.size();
+        size_t pages = (n + NODE_SIZE - 1) / NODE_SIZE;
+        size_t slices = (size_t)std::ceil(std::sqrt((double)pages));
+        size_t slice_size = ((pages + slices - 1) / slices) * NODE_SIZE;
+        
+        std::sort(entries.begin(), entries.end(), [&](int a, int b) {
+            return get_box(a).centerX() < get_box(b).centerX();
+        });
+        for (size_t start = 0; start < n; start += slice_size) {
+            auto end = entries.begin() + std::min(start + slice_size, n);
+            std::sort(entries.begin() + start, end, [&](int a, int b) {
+                return get_box(a).centerY() < get_box(b).centerY();
+            });
+        }
+    }
+    
+public:
+    // Bulk load the tree over `lanes_` (kept by reference, must outlive the tree)
+    // Time: O(n·log(n))
+    LaneRTree(const std::vector<Segment>& lanes_) : lanes(lanes_) {
+        lane_boxes.reserve(lanes.size());
+        for (int i = 0; i < (int)lanes.size(); i++) {
+            lane_boxes.push_back(laneBox(lanes[i]));
+            if (!lanes[i].empty()) 
+                items.push_back(i);
+        }
+        if (items.empty()) 
+            return;
+        
+        // Leaf level: pack STR-ordered lanes into leaves
+        // Levels are built in scratch vectors, then laid out once, bottom-up
+        strOrder(items, [&](int i) -> const Box& { return lane_boxes[i]; });
+        std::vector<std::vector<Node>> levels(1);
+        for (size_t start = 0; start < items.size(); start += NODE_SIZE) {
+            Node leaf{Box::empty(), (int)start, 
+                      (int)std::min<size_t>(NODE_SIZE, items.size() - start), true};
+            for (int k = 0; k < leaf.count; k++) {
+                leaf.box.expand(lane_boxes[items[start + k]]);
+            }
+            levels[0].push_back(leaf);
+        }
+        
+        // Upper levels: STR-order the level below in place, then pack runs of
+        // NODE_SIZE into parents (`first` is relative to the level below)
+        while (levels.back().size() > 1) {
+            std::vector<Node>& below = levels.back();
+            std::vector<int> order(below.size());
+            for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+            strOrder(order, [&](int i) -> const Box& { return below[i].box; });
+            
+            std::vector<Node> sorted;
+            sorted.reserve(below.size());
+            for (int i : order) {
+                sorted.push_back(below[i]);
+            }
+            below.swap(sorted);
+            
+            std::vector<Node> parents;
+            for (size_t start = 0; start < below.size(); start += NODE_SIZE) {
+                Node parent{Box::empty(), (int)start, 
+                            (int)std::min<size_t>(NODE_SIZE, below.size() - start), false};
+                for (int k = 0; k < parent.count; k++) {
+                    parent.box.expand(below[start + k].box);
+                }
+                parents.push_back(parent);
+            }
+            levels.push_back(std::move(parents));
+        }
+        
+        // Concatenate the levels; inner nodes' children become absolute indices
+        size_t total = 0;
+        for (const auto& level : levels) total += level.size();
+        nodes.reserve(total);
+        size_t below_begin = 0;
+        for (const auto& level : levels) {
+            size_t level_begin = nodes.size();
+            for (Node node : level) {
+                if (!node.leaf) 
+                    node.first += below_begin;
+                nodes.push_back(node);
+            }
+            below_begin = level_begin;
+        }
+    }
+    
+    // Number of nodes in the packed array (all live)
+    size_t nodeCount() const {
+        return nodes.size();
+    }
+    
+    // Closest lane to p (best-first search on box distance)
+    // Time: O(log n) typical
+    NearestLane nearest(const Point& p) const {
+        NearestLane best{-1, std::numeric_limits<double>::infinity()};
+        if (nodes.empty()) 
+            return best;
+        
+        double best_sq = best.distance;
+        
+        // Min-heap of (box distance², node index)
+        using Entry = std::pair<double, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+        frontier.emplace(nodes.back().box.distSq(p), (int)nodes.size() - 1);
+        
+        while (!frontier.empty()) {
+            auto [dist_sq, idx] = frontier.top();
+            frontier.pop();
+            
+            // Every remaining node is at least this far: done
+            if (dist_sq >= best_sq) 
+                break;
+            
+            const Node& node = nodes[idx];
+            for (int k = 0; k < node.count; k++) {
+                if (node.leaf) {
+                    int lane = items[node.first + k];
+                    if (lane_boxes[lane].distSq(p) >= best_sq) 
+                        continue;
+                    double d = pointLaneDistSq(p, lanes[lane]);
+                    if (d < best_sq) {
+                        best_sq = d;
+                        best.lane = lane;
+                    }
+                } else {
+                    double d = nodes[node.first + k].box.distSq(p);
+                    if (d < best_sq) 
+                        frontier.emplace(d, node.first + k);
+                }
+            }
+        }
+        
+        best.distance = std::sqrt(best_sq);
+        return best;
+    }
+    
+    // Indices of all lanes that pass through the query box
+    // Time: O(log n + k) typical, k = number of results
+    std::vector<int> overlapping(const Box& query) const {
+        std::vector<int> result;
+        if (nodes.empty() || !nodes.back().box.overlaps(query)) 
+            return result;
+        
+        std::vector<int> stack = {(int)nodes.size() - 1};
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            
+            for (int k = 0; k < node.count; k++) {
+                if (!node.leaf) {
+                    if (nodes[node.first + k].box.overlaps(query)) 
+                        stack.push_back(node.first + k);
+                    continue;
+                }
+                
+                // Leaf entry: box filter, then exact polyline-vs-box test
+                int lane = items[node.first + k];
+                if (!lane_boxes[lane].overlaps(query)) 
+                    continue;
+                const Segment& seg = lanes[lane];
+                bool hit = segmentOverlapsBox(seg[0], seg[0], query);
+                for (size_t i = 1; i < seg.size() && !hit; i++) {
+                    hit = segmentOverlapsBox(seg[i - 1], seg[i], query);
+                }
+                if (hit) 
+                    result.push_back(lane);
+            }
+        }
+        return result;
+    }
+    
+    // Batched nearest-lane queries, spread across threads
+    // Queries are processed in x-sorted order so neighboring queries on the
+    // same thread touch the same tree nodes; results keep input order
+    std::vector<NearestLane> nearestBatch(const std::vector<Point>& queries, 
+                                          unsigned num_threads = std::thread::hardware_concurrency()) const {
+        std::vector<int> order(queries.size());
+        for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            return queries[a].x < queries[b].x;
+        });
         
-        // Calculate line for this lane and add to appropriate group
-        Line lane_line = getLine(lane);
-        line_groups[lane_line].push_back(lane);
+        std::vector<NearestLane> result(queries.size());
+        parallelFor(order.size(), std::max(1u, num_threads), 256, [&](size_t i) {
+            result[order[i]] = nearest(queries[order[i]]);
+        });
+        return result;
+    }
+    
+    // Batched box-overlap queries, spread across threads
+    std::vector<std::vector<int>> overlappingBatch(const std::vector<Box>& queries, 
+                                                   unsigned num_threads = std::thread::hardware_concurrency()) const {
+        std::vector<std::vector<int>> result(queries.size());
+        parallelFor(queries.size(), std::max(1u, num_threads), 64, [&](size_t i) {
+            result[i] = overlapping(queries[i]);
+        });
+        return result;
     }
+};
 
-    // Step 3: Merge segments for each unique line
-    std::vector<Segment> result;
-    for (const auto& [line, segments] : line_groups) {
-        // Merge all segments on this line
-        Segment merged = mergeSegments(segments);
+// ============================================================================
+// BENCHMARK: merge modes, R-tree vs brute-force linear scan
+// ============================================================================
+
+int main() {
+    // Small merge example: two overlapping runs on y = x, one vertical lane
+    std::vector<Segment> lanes = {
+        {Point(0, 0), Point(2, 2)}, 
+        {Point(1, 1), Point(3, 3)}, 
+        {Point(5, 0), Point(5, 4)}
+    };
+    std::vector<Segment> merged = mergeLanes(lanes);
+    std::cout << "Merged lanes: " << merged.size() << " (expected: 2)" << std::endl;
+    
+    
+    // Same line at UTM-scale coordinates: 20 overlapping 1m lanes on
+    // y = y0 + 0.3·(x - x0); only rounding differs between their points
+    const double x0 = 512345.678, y0 = 4012345.678;
+    std::vector<Segment> utm_lanes;
+    for (int i = 0; i < 20; i++) {
+        double xa = x0 + 0.5 * i, xb = xa + 1;
+        utm_lanes.push_back({Point(xa, y0 + 0.3 * (xa - x0)), Point(xb, y0 + 0.3 * (xb - x0))});
+    }
+    std::cout << "Merged UTM lanes: " << mergeLanes(utm_lanes).size() 
+              << " (expected: 1)" << std::endl;
+    
+    // Polylines: an L-shaped lane whose vertical leg is overlapped by a second
+    // lane that continues east, plus a closed square loop
+    auto printPolylines = [](const std::vector<Segment>& polylines) {
+        for (const auto& polyline : polylines) {
+            std::cout << "  ";
+            for (const auto& p : polyline) {
+                std::cout << "(" << p.x << "," << p.y << ")";
+            }
+            std::cout << std::endl;
+        }
+    };
+    std::vector<Segment> l_shape = {
+        {Point(0, 0), Point(10, 0), Point(10, 10)}, 
+        {Point(10, 5), Point(10, 10), Point(15, 10)}
+    };
+    std::cout << "L-shape polylines (expected: (0,0)(10,0)(10,10)(15,10)):" << std::endl;
+    printPolylines(mergeLanePolylines(l_shape));
+    
+    std::vector<Segment> loop = {
+        {Point(20, 0), Point(24, 0), Point(24, 4), Point(20, 4), Point(20, 0)}
+    };
+    std::cout << "Loop polylines (expected: (20,0)(24,0)(24,4)(20,4)(20,0), closed):" << std::endl;
+    printPolylines(mergeLanePolylines(loop));
+    
+    LaneRTree small_index(merged);
+    NearestLane near = small_index.nearest(Point(4, 1));
+    std::cout << "Nearest lane to (4,1): distance " << near.distance 
+              << " (expected: 1, the vertical lane)" << std::endl;
+    
+    // Tiled streaming: one line cut by a tile seam at x = 10
+    std::vector<std::vector<Segment>> tiles = {
+        {{Point(0, 0), Point(6, 0)}, {Point(5, 0), Point(10, 0)}}, 
+        {{Point(10, 0), Point(14, 0)}, {Point(12, 0), Point(20, 0)}}
+    };
+    size_t next_tile = 0;
+    std::vector<Segment> tiled;
+    mergeLanesTiled(
+        [&](std::vector<Segment>& tile) {
+            if (next_tile == tiles.size()) 
+                return false;
+            tile = tiles[next_tile++];
+            return true;
+        }, 
+        [&](std::vector<Segment>&& runs) {
+            tiled.insert(tiled.end(), runs.begin(), runs.end());
+        }, 2);
+    std::cout << "Tiled runs: " << tiled.size() << " (expected: 2, touching at the x = 10 seam)" << std::endl;
+    
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::duration d) { 
+        return std::chrono::duration<double, std::milli>(d).count(); 
+    };
+    
+    // Parallel merge vs serial: 10 lanes on each of 20k random lines (UTM-like)
+    {
+        const int LINES = 20000, PER_LINE = 10;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> unit(0, 1);
+        std::vector<Segment> map_lanes;
+        for (int l = 0; l < LINES; l++) {
+            double angle = unit(rng) * M_PI;
+            double ox = 500000 + unit(rng) * 10000, oy = 4000000 + unit(rng) * 10000;
+            double cx = std::cos(angle), cy = std::sin(angle);
+            for (int k = 0; k < PER_LINE; k++) {
+                double t0 = k * 30 + unit(rng) * 40, t1 = t0 + 10 + unit(rng) * 20;
+                map_lanes.push_back({Point(ox + t0 * cx, oy + t0 * cy), Point(ox + t1 * cx, oy + t1 * cy)});
+            }
+        }
+        std::shuffle(map_lanes.begin(), map_lanes.end(), rng);
         
-        // Add to result if merge produced valid segment
-        if (!merged.empty()) {
-            result.push_back(merged);
+        auto t0 = Clock::now();
+        std::vector<Segment> serial = mergeLanes(map_lanes);
+        auto t1 = Clock::now();
+        std::vector<Segment> parallel = mergeLanesParallel(map_lanes, 4);
+        auto t2 = Clock::now();
+        
+        bool same = serial.size() == parallel.size();
+        for (size_t i = 0; i < serial.size() && same; i++) {
+            same = serial[i].size() == parallel[i].size();
+            for (size_t k = 0; k < serial[i].size() && same; k++) {
+                same = serial[i][k].x == parallel[i][k].x && serial[i][k].y == parallel[i][k].y;
+            }
         }
+        
+        std::cout << "\n=== PARALLEL MERGE: " << map_lanes.size() << " lanes, 4 threads ===" << std::endl;
+        std::cout << "mergeLanes:         " << ms(t1 - t0) << " ms" << std::endl;
+        std::cout << "mergeLanesParallel: " << ms(t2 - t1) << " ms" << std::endl;
+        std::cout << "Runs: " << serial.size() << ", same output: " << (same ? "yes" : "NO") << std::endl;
     }
     
-    return result;
+    // 1M random short segments in a 10km × 10km map
+    const int N = 1000000;
+    const int Q = 2000;
+    const int BRUTE_Q = 50;  // Brute force is slow: check a prefix of the queries
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> coord(0, 10000);
+    std::uniform_real_distribution<double> step(-20, 20);
+    
+    std::vector<Segment> segments;
+    segments.reserve(N);
+    for (int i = 0; i < N; i++) {
+        double x = coord(rng), y = coord(rng);
+        segments.push_back({Point(x, y), Point(x + step(rng), y + step(rng))});
+    }
+    std::vector<Point> queries;
+    for (int i = 0; i < Q; i++) {
+        queries.emplace_back(coord(rng), coord(rng));
+    }
+    
+    auto t0 = Clock::now();
+    LaneRTree index(segments);
+    auto t1 = Clock::now();
+    std::vector<NearestLane> tree_result = index.nearestBatch(queries, 1);
+    auto t2 = Clock::now();
+    
+    // Brute force: scan every segment for every query
+    int mismatches = 0;
+    for (int q = 0; q < BRUTE_Q; q++) {
+        double best = std::numeric_limits<double>::infinity();
+        for (const auto& seg : segments) {
+            best = std::min(best, pointLaneDistSq(queries[q], seg));
+        }
+        if (std::abs(std::sqrt(best) - tree_result[q].distance) > 1e-9) 
+            mismatches++;
+    }
+    auto t3 = Clock::now();
+    
+    // Average time per query in microseconds
+    auto us = [](Clock::duration d, int queries) { 
+        return std::chrono::duration<double, std::micro>(d).count() / queries; 
+    };
+    std::cout << "\n=== NEAREST LANE: " << N << " segments, " << Q << " queries ===" << std::endl;
+    std::cout << "R-tree build:   " << ms(t1 - t0) << " ms, " 
+              << index.nodeCount() << " nodes" << std::endl;
+    std::cout << "R-tree query:   " << us(t2 - t1, Q) << " us/query" << std::endl;
+    std::cout << "Brute force:    " << us(t3 - t2, BRUTE_Q) << " us/query" << std::endl;
+    std::cout << "Mismatches:     " << mismatches << " (expected: 0)" << std::endl;
+    
+    // Box overlap: 200m × 200m windows
+    std::vector<Box> boxes;
+    for (int i = 0; i < Q; i++) {
+        double x = coord(rng), y = coord(rng);
+        boxes.push_back(Box{x, y, x + 200, y + 200});
+    }
+    auto t4 = Clock::now();
+    std::vector<std::vector<int>> box_result = index.overlappingBatch(boxes, 1);
+    auto t5 = Clock::now();
+    
+    mismatches = 0;
+    for (int q = 0; q < BRUTE_Q; q++) {
+        size_t count = 0;
+        for (const auto& seg : segments) {
+            if (segmentOverlapsBox(seg[0], seg[1], boxes[q])) 
+                count++;
+        }
+        if (count != box_result[q].size()) 
+            mismatches++;
+    }
+    auto t6 = Clock::now();
+    
+    std::cout << "\n=== BOX OVERLAP: " << Q << " queries ===" << std::endl;
+    std::cout << "R-tree query:   " << us(t5 - t4, Q) << " us/query" << std::endl;
+    std::cout << "Brute force:    " << us(t6 - t5, BRUTE_Q) << " us/query" << std::endl;
+    std::cout << "Mismatches:     " << mismatches << " (expected: 0)" << std::endl;
+    
+    return 0;
 }
\ No newline at end of file
@@ -17,9 +17,236 @@ OPTIMIZED APPROACH (Current Implementation):
 - Single pass through sorted intervals merging as we go
 - Time Complexity: O(n log n) due to sorting
 - Space Complexity: O(n) for result storage
+
+FLAT OVERLOAD (merge(std::vector<Interval>&)):
+- vector<vector<int>> costs one heap allocation per interval and sorting
+  compares inner vectors lexicographically
+- Interval is a plain {start, end} pair stored contiguously
+- LSD radix sort on the start key (3 passes of 11 bits), then merge in place
+  by compacting into the front of the same array
+- Time Complexity: O(n), memory-bound for large n
+- Space Complexity: O(n) scratch buffer for the radix sort
+
+PARALLEL MODE (mergeParallel):
+- Parallel LSD radix sort: per pass, every thread histograms its chunk, one
+  prefix sum turns (digit, thread) counts into scatter offsets, then every
+  thread scatters its chunk (stable, so the order matches the serial sort)
+- Each thread merges its own chunk of the sorted array independently
+- One linear stitch pass joins chunk results across chunk boundaries
+- Output is identical to the serial merge
+- Time Complexity: O(n/p + p·2^11 + m) where p = threads, m = merged count
+
+DYNAMIC SET (IntervalSet):
+- Re-merging from scratch on every new interval costs O(n log n) per update
+- Keep the merged result as disjoint ranges in a balanced tree (std::map,
+  start -> end), so each update only touches its neighbours
+- insert absorbs overlapping neighbours, remove cuts a range out,
+  stab finds the range containing a point, overlapping lists ranges in [a, b]
+- Time Complexity: O(log n + k) per operation, k = ranges touched/returned
+
+STREAMING MODE (mergeSortedRuns):
+- Input: k binary files, each an array of Interval already sorted by start,
+  together larger than RAM
+- Each file is memory-mapped and read sequentially; a loser tree picks the
+  smallest start among the k run heads with log k comparisons per interval
+- Merged intervals go to a sink callback as soon as they are final;
+  consumed pages are released, so memory stays O(k) plus a window per run
+- Time Complexity: O(N log k) where N = total intervals
+
+COVERAGE ANALYTICS (analyzeCoverage):
+- One sorted event array (+1 at each start, -1 at each end; starts before
+  ends at equal positions, matching merge()'s touching-overlaps rule)
+- Depth after every event is a prefix sum of the deltas (SSE2, 4 lanes)
+- One sweep over the events yields total covered length, the gaps between
+  covered ranges, and the maximum overlap depth with where it first occurs
+- Time Complexity: O(n log n) for the event sort, O(n) for everything else
 */
 
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <thread>
+#include <iostream>
+#include <string>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Flat interval: contiguous {start, end} pair, no per-interval allocation
+struct Interval {
+    int start;
+    int end;
+};
+
 class Solution {
+private:
+    static const int RADIX_BITS = 11;                  // 3 passes cover 32 bits
+    static const int RADIX_SIZE = 1 << RADIX_BITS;
+    static const int RADIX_PASSES = 3;
+    
+    // Map signed start to unsigned so negative starts sort first
+    static uint32_t radixKey(const Interval& iv) {
+        return (uint32_t)iv.start ^ 0x80000000u;
+    }
+    
+    // Stable LSD radix sort of intervals by start
+    // Time: O(n), one histogram pass + up to 3 scatter passes
+    static void radixSortByStart(std::vector<Interval>& intervals) {
+        size_t n = intervals.size();
+        
+        // Small inputs: radix overhead (histograms, scratch buffer) not worth it
+        if (n < 256) {
+            std::sort(intervals.begin(), intervals.end(), 
+                [](const Interval& a, const Interval& b) { return a.start < b.start; });
+            return;
+        }
+        
+        // Build all digit histograms in a single read of the data
+        std::vector<size_t> counts(RADIX_PASSES * RADIX_SIZE, 0);
+        for (const auto& iv : intervals) {
+            uint32_t key = radixKey(iv);
+            for (int pass = 0; pass < RADIX_PASSES; pass++) {
+                counts[pass * RADIX_SIZE + ((key >> (pass * RADIX_BITS)) & (RADIX_SIZE - 1))]++;
+            }
+        }
+        
+        std::vector<Interval> buffer(n);
+        Interval* src = intervals.data();
+        Interval* dst = buffer.data();
+        
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            size_t* count = &counts[pass * RADIX_SIZE];
+            int shift = pass * RADIX_BITS;
+            
+            // Every key has the same digit: this pass would not move anything
+            uint32_t digit0 = (radixKey(src[0]) >> shift) & (RADIX_SIZE - 1);
+            if (count[digit0] == n) 
+                continue;
+            
+            // Exclusive prefix sum: count[d] = first output slot for digit d
+            size_t sum = 0;
+            for (int d = 0; d < RADIX_SIZE; d++) {
+                size_t c = count[d];
+                count[d] = sum;
+                sum += c;
+            }
+            
+            // Scatter into the other buffer (stable: keeps previous-pass order)
+            for (size_t i = 0; i < n; i++) {
+                uint32_t digit = (radixKey(src[i]) >> shift) & (RADIX_SIZE - 1);
+                dst[count[digit]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+        
+        // Odd number of executed passes leaves the result in the scratch buffer
+        if (src != intervals.data()) 
+            intervals.swap(buffer);
+    }
+    
+    // Run fn(t) on threads t = 0..num_threads-1 and wait for all of them
+    template <typename Fn>
+    static void runOnThreads(unsigned num_threads, Fn fn) {
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < num_threads; t++) {
+            pool.emplace_back(fn, t);
+        }
+        fn(0u);  // Calling thread takes chunk 0
+        for (auto& th : pool) {
+            th.join();
+        }
+    }
+    
+    // Stable parallel LSD radix sort of intervals by start
+    // chunk t = [bounds[t], bounds[t+1]) is owned by thread t in every pass
+    // Time: O(n/p + p·RADIX_SIZE) per pass
+    static void parallelRadixSortByStart(std::vector<Interval>& intervals, 
+                                         const std::vector<size_t>& bounds) {
+        size_t n = intervals.size();
+        unsigned num_threads = bounds.size() - 1;
+        
+        std::vector<Interval> buffer(n);
+        Interval* src = intervals.data();
+        Interval* dst = buffer.data();
+        
+        // counts[t * RADIX_SIZE + d] = elements with digit d in chunk t
+        std::vector<size_t> counts((size_t)num_threads * RADIX_SIZE);
+        
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            int shift = pass * RADIX_BITS;
+            
+            // Step 1: Per-chunk histograms
+            runOnThreads(num_threads, [&](unsigned t) {
+                size_t* count = &counts[(size_t)t * RADIX_SIZE];
+                std::fill(count, count + RADIX_SIZE, 0);
+                for (size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+                    count[(radixKey(src[i]) >> shift) & (RADIX_SIZE - 1)]++;
+                }
+            });
+            
+            // Step 2: Exclusive prefix sum, digit-major then thread order
+            // Digit d of chunk t goes after digit d of chunks 0..t-1: stable
+            size_t sum = 0;
+            bool single_digit = false;
+            for (int d = 0; d < RADIX_SIZE; d++) {
+                size_t digit_total = 0;
+                for (unsigned t = 0; t < num_threads; t++) {
+                    size_t c = counts[(size_t)t * RADIX_SIZE + d];
+                    counts[(size_t)t * RADIX_SIZE + d] = sum;
+                    sum += c;
+                    digit_total += c;
+                }
+                if (digit_total == n) 
+                    single_digit = true;
+            }
+            
+            // Every key has the same digit: this pass would not move anything
+            if (single_digit) 
+                continue;
+            
+            // Step 3: Per-chunk scatter into the other buffer
+            runOnThreads(num_threads, [&](unsigned t) {
+                size_t* offset = &counts[(size_t)t * RADIX_SIZE];
+                for (size_t i = bounds[t]; i < bounds[t + 1]; i++) {
+                    uint32_t digit = (radixKey(src[i]) >> shift) & (RADIX_SIZE - 1);
+                    dst[offset[digit]++] = src[i];
+                }
+            });
+            std::swap(src, dst);
+        }
+        
+        if (src != intervals.data()) 
+            intervals.swap(buffer);
+    }
+    
+    // Merge sorted intervals[lo, hi) in place, compacting into the front
+    // Returns: number of merged intervals written at intervals[lo..]
+    // Time: O(hi - lo)
+    static size_t mergeSortedRange(std::vector<Interval>& intervals, size_t lo, size_t hi) {
+        if (lo == hi) 
+            return 0;
+        
+        size_t out = lo;
+        for (size_t i = lo + 1; i < hi; i++) {
+            if (intervals[out].end < intervals[i].start) {
+                intervals[++out] = intervals[i];
+            } else {
+                intervals[out].end = std::max(intervals[out].end, intervals[i].end);
+            }
+        }
+        return out + 1 - lo;
+    }
+
 public:
     std::vector<std::vector<int>> merge(std::vector<std::vector<int>>& intervals) {
         // Get number of intervals
@@ -28,7 +255,7 @@ public:
         // Sort intervals by start time (first element of each interval)
         // After sorting: [[1,3], [2,6], [8,10]] becomes sorted if not already
         // Time: O(n log n)
-        sort(intervals.begin(), intervals.end());
+        std::sort(intervals.begin(), intervals.end());
         
         // Result vector to store merged intervals
         std::vector<std::vector<int>> ans;
@@ -49,7 +276,7 @@ public:
                 // Merge by extending the end of last interval
                 // Take maximum of both ends to cover entire range
                 // Example: merge [1,4] and [3,6] → [1,6]
-                ans.back()[1] = max(ans.back()[1], intervals[i][1]);
+                ans.back()[1] = std::max(ans.back()[1], intervals[i][1]);
                 
                 // Note: No need to update start time because intervals are sorted
                 // The start of ans.back() is already the minimum start
@@ -61,6 +288,65 @@ public:
         // Return merged intervals
         return ans;
     }
+    
+    // Merge flat intervals in place
+    // After return, intervals holds only the merged intervals, sorted by start
+    // Time: O(n), Space: O(n) scratch for the radix sort
+    void merge(std::vector<Interval>& intervals) {
+        if (intervals.empty()) 
+            return;
+        
+        // Sort by start key without comparisons
+        radixSortByStart(intervals);
+        
+        // Compact merged intervals into the front of the array
+        // The write position never overtakes the read position, so this is safe in place
+        intervals.resize(mergeSortedRange(intervals, 0, intervals.size()));
+    }
+    
+    // Parallel version of merge(std::vector<Interval>&), same output
+    // Time: O(n/p + p·2^11 + m) where p = num_threads, m = merged intervals
+    void mergeParallel(std::vector<Interval>& intervals, 
+                       unsigned num_threads = std::thread::hardware_concurrency()) {
+        size_t n = intervals.size();
+        
+        // Too little work to amortize thread startup: use the serial path
+        if (num_threads <= 1 || n < 65536) {
+            merge(intervals);
+            return;
+        }
+        
+        // Split the array into one contiguous chunk per thread
+        std::vector<size_t> bounds(num_threads + 1);
+        for (unsigned t = 0; t <= num_threads; t++) {
+            bounds[t] = n * t / num_threads;
+        }
+        
+        // Step 1: Parallel sort by start
+        parallelRadixSortByStart(intervals, bounds);
+        
+        // Step 2: Merge every chunk independently
+        std::vector<size_t> merged_count(num_threads);
+        runOnThreads(num_threads, [&](unsigned t) {
+            merged_count[t] = mergeSortedRange(intervals, bounds[t], bounds[t + 1]);
+        });
+        
+        // Step 3: Stitch chunk results; only a chunk's first few intervals can
+        // overlap the previous chunk's last one, the rest are copied through
+        size_t out = 0;
+        for (unsigned t = 0; t < num_threads; t++) {
+            for (size_t i = bounds[t]; i < bounds[t] + merged_count[t]; i++) {
+                if (i == 0) 
+                    continue;  // intervals[0] is already in place
+                if (intervals[out].end < intervals[i].start) {
+                    intervals[++out] = intervals[i];
+                } else {
+                    intervals[out].end = std::max(intervals[out].end, intervals[i].end);
+                }
+            }
+        }
+        intervals.resize(out + 1);
+    }
 };
 
 /*
@@ -86,4 +372,466 @@ Step-by-step:
    ans = [[1,6], [8,10], [15,18]]
 
 Final result: [[1,6], [8,10], [15,18]]
-*/
\ No newline at end of file
+*/
+
+/*
+DYNAMIC INTERVAL SET
+Invariant: stored ranges are disjoint and non-touching (each end < next start),
+i.e. exactly what merge() would return for everything inserted so far
+*/
+class IntervalSet {
+private:
+    std::map<int, int> ranges;  // start -> end
+
+    // First range that could overlap [start, ...]: the one before
+    // upper_bound(start) if it reaches start, otherwise upper_bound(start)
+    std::map<int, int>::const_iterator firstReaching(int start, bool touching) const {
+        auto it = ranges.upper_bound(start);
+        if (it != ranges.begin()) {
+            auto prev = std::prev(it);
+            if (touching ? prev->second >= start : prev->second > start) 
+                return prev;
+        }
+        return it;
+    }
+
+public:
+    // Add [start, end], absorbing every range it overlaps or touches
+    // Returns: the merged range now containing [start, end]
+    // Time: O(log n + k), k = absorbed ranges
+    Interval insert(int start, int end) {
+        auto it = firstReaching(start, true);
+        
+        // Absorb overlapping ranges (same overlap rule as merge())
+        while (it != ranges.end() && it->first <= end) {
+            start = std::min(start, it->first);
+            end = std::max(end, it->second);
+            it = ranges.erase(it);
+        }
+        
+        ranges.emplace_hint(it, start, end);
+        return Interval{start, end};
+    }
+    
+    // Remove the open range (start, end) from the set
+    // A range [s, e] that straddles it is cut to [s, start] and/or [end, e];
+    // the endpoints start and end stay covered, even when s == start or
+    // e == end (the piece left is the single point)
+    // Time: O(log n + k), k = ranges affected
+    void remove(int start, int end) {
+        if (start >= end) 
+            return;
+        
+        auto it = firstReaching(start, false);
+        while (it != ranges.end() && it->first < end) {
+            int s = it->first;
+            int e = it->second;
+            it = ranges.erase(it);
+            
+            // Keep the parts sticking out on either side
+            if (s <= start) 
+                ranges.emplace_hint(it, s, start);
+            if (e >= end) 
+                it = ranges.emplace_hint(it, end, e);
+        }
+    }
+    
+    // Range containing point x, if any
+    // Returns: true and fills `out` if x is covered
+    // Time: O(log n)
+    bool stab(int x, Interval& out) const {
+        auto it = ranges.upper_bound(x);
+        if (it == ranges.begin()) 
+            return false;
+        --it;
+        if (it->second < x) 
+            return false;
+        out = Interval{it->first, it->second};
+        return true;
+    }
+    
+    // All stored ranges that overlap [start, end], in order
+    // Time: O(log n + k), k = ranges returned
+    std::vector<Interval> overlapping(int start, int end) const {
+        std::vector<Interval> result;
+        for (auto it = firstReaching(start, true); 
+             it != ranges.end() && it->first <= end; ++it) {
+            result.push_back(Interval{it->first, it->second});
+        }
+        return result;
+    }
+    
+    size_t size() const {
+        return ranges.size();
+    }
+    
+    // All ranges in order (same as merge() over every inserted interval)
+    // Time: O(n)
+    std::vector<Interval> toVector() const {
+        std::vector<Interval> result;
+        result.reserve(ranges.size());
+        for (const auto& [s, e] : ranges) {
+            result.push_back(Interval{s, e});
+        }
+        return result;
+    }
+};
+
+/*
+STREAMING K-WAY MERGE OF SORTED INTERVAL FILES
+*/
+
+// Read-only memory mapping of one sorted run file (raw Interval array)
+class MappedIntervalRun {
+private:
+    // Release consumed pages every this many intervals (8 MiB of Interval)
+    static const size_t RELEASE_STEP = 1 << 20;
+    
+    const Interval* data = nullptr;
+    size_t count = 0;
+    size_t pos = 0;
+    size_t released = 0;  // Intervals whose pages were handed back
+    size_t bytes = 0;
+
+public:
+    explicit MappedIntervalRun(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) 
+            throw std::runtime_error("Cannot open interval run: " + path);
+        
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Cannot stat interval run: " + path);
+        }
+        bytes = st.st_size;
+        count = bytes / sizeof(Interval);
+        
+        if (bytes > 0) {
+            void* mapped = mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Cannot map interval run: " + path);
+            }
+            // Sequential hint: kernel reads ahead and drops pages behind us
+            madvise(mapped, bytes, MADV_SEQUENTIAL);
+            data = static_cast<const Interval*>(mapped);
+        }
+        close(fd);  // The mapping stays valid after close
+    }
+    
+    ~MappedIntervalRun() {
+        if (data) 
+            munmap(const_cast<Interval*>(data), bytes);
+    }
+    
+    MappedIntervalRun(const MappedIntervalRun&) = delete;
+    MappedIntervalRun& operator=(const MappedIntervalRun&) = delete;
+    
+    bool done() const { return pos == count; }
+    const Interval& head() const { return data[pos]; }
+    
+    void advance() {
+        pos++;
+        
+        // Hand back fully consumed pages so resident memory stays bounded
+        if (pos - released >= RELEASE_STEP) {
+            long page = sysconf(_SC_PAGESIZE);
+            size_t from = (released * sizeof(Interval)) / page * page;
+            size_t to = (pos * sizeof(Interval)) / page * page;
+            if (to > from) {
+                madvise((char*)data + from, to - from, MADV_DONTNEED);
+            }
+            released = pos;
+        }
+    }
+};
+
+// Tournament tree of losers over k sorted runs
+// tree[0] holds the overall winner (smallest head); tree[1..k-1] hold the
+// loser of the match played at that node, so replacing the winner only
+// replays the log k matches on its leaf-to-root path
+class LoserTree {
+private:
+    std::vector<MappedIntervalRun*> runs;
+    std::vector<int> tree;
+    int k;
+    
+    // Does run a's head come before run b's? Exhausted runs lose to everything
+    bool beats(int a, int b) const {
+        if (runs[a]->done()) return false;
+        if (runs[b]->done()) return true;
+        if (runs[a]->head().start != runs[b]->head().start) 
+            return runs[a]->head().start < runs[b]->head().start;
+        return a < b;  // Stable tie-break by run index
+    }
+
+public:
+    // Time: O(k)
+    explicit LoserTree(std::vector<MappedIntervalRun*> runs_) 
+        : runs(std::move(runs_)), tree(std::max<size_t>(runs.size(), 1), -1), k(runs.size()) {
+        // Leaves are k..2k-1; a node stores the first winner that reaches it,
+        // then the loser once its second subtree's winner arrives
+        for (int leaf = 0; leaf < k; leaf++) {
+            int winner = leaf;
+            int node = (leaf + k) / 2;
+            for (; node > 0; node /= 2) {
+                if (tree[node] == -1) {
+                    tree[node] = winner;
+                    break;
+                }
+                if (beats(tree[node], winner)) 
+                    std::swap(tree[node], winner);
+            }
+            if (node == 0) 
+                tree[0] = winner;
+        }
+    }
+    
+    // Run holding the smallest head, or -1 when every run is exhausted
+    int winner() const {
+        return (k == 0 || runs[tree[0]]->done()) ? -1 : tree[0];
+    }
+    
+    // Consume the winner's head and replay its path
+    // Time: O(log k)
+    void pop() {
+        int winner = tree[0];
+        runs[winner]->advance();
+        for (int node = (winner + k) / 2; node > 0; node /= 2) {
+            if (beats(tree[node], winner)) 
+                std::swap(tree[node], winner);
+        }
+        tree[0] = winner;
+    }
+};
+
+// Merge intervals from k files, each already sorted by start
+// sink(const Interval&) receives merged intervals in order as they complete
+// Returns: number of merged intervals emitted
+// Time: O(N log k), Memory: O(k) plus one page-release window per run
+template <typename Sink>
+size_t mergeSortedRuns(const std::vector<std::string>& paths, Sink sink) {
+    std::vector<std::unique_ptr<MappedIntervalRun>> owned;
+    std::vector<MappedIntervalRun*> runs;
+    for (const auto& path : paths) {
+        owned.push_back(std::make_unique<MappedIntervalRun>(path));
+        runs.push_back(owned.back().get());
+    }
+    
+    LoserTree tree(runs);
+    size_t emitted = 0;
+    bool have_current = false;
+    Interval current{0, 0};
+    
+    for (int run = tree.winner(); run != -1; run = tree.winner()) {
+        Interval next = runs[run]->head();
+        tree.pop();
+        
+        // Same overlap rule as Solution::merge
+        if (!have_current) {
+            current = next;
+            have_current = true;
+        } else if (current.end < next.start) {
+            sink(current);  // Nothing later can start before next.start: final
+            emitted++;
+            current = next;
+        } else {
+            current.end = std::max(current.end, next.end);
+        }
+    }
+    
+    if (have_current) {
+        sink(current);
+        emitted++;
+    }
+    return emitted;
+}
+
+/*
+INTERVAL COVERAGE ANALYTICS
+*/
+
+struct CoverageStats {
+    long long covered_length = 0;  // Total length covered by at least one interval
+    std::vector<Interval> gaps;    // Uncovered ranges between covered ones, in order
+    int max_depth = 0;             // Most intervals overlapping at one place
+    Interval max_depth_at{0, 0};   // First range where max_depth is reached
+};
+
+// Replace a[i] by a[0] + ... + a[i]
+// SSE2: two shifted adds give the prefix within 4 lanes, then the running
+// total from the previous block is broadcast and added
+// Time: O(n)
+void prefixSumInPlace(std::vector<int>& a) {
+    size_t n = a.size();
+    size_t i = 0;
+#ifdef __SSE2__
+    __m128i carry = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)&a[i]);
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));   // [a, a+b, b+c, c+d]
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));   // [a, a+b, a+b+c, a+b+c+d]
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128((__m128i*)&a[i], x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));  // Broadcast last lane
+    }
+#endif
+    int running = (i > 0) ? a[i - 1] : 0;
+    for (; i < n; i++) {
+        running += a[i];
+        a[i] = running;
+    }
+}
+
+// Coverage statistics of a set of intervals in one sweep
+// Time: O(n log n), Space: O(n)
+CoverageStats analyzeCoverage(const std::vector<Interval>& intervals) {
+    CoverageStats stats;
+    if (intervals.empty()) 
+        return stats;
+    
+    // Step 1: Build one sorted event array
+    // key = (biased position << 1) | is_end, so starts sort before ends
+    std::vector<uint64_t> events;
+    events.reserve(intervals.size() * 2);
+    for (const auto& iv : intervals) {
+        events.push_back((uint64_t)((uint32_t)iv.start ^ 0x80000000u) << 1);
+        events.push_back(((uint64_t)((uint32_t)iv.end ^ 0x80000000u) << 1) | 1);
+    }
+    std::sort(events.begin(), events.end());
+    
+    // Step 2: Split into positions and deltas, then depth = prefix sum
+    size_t m = events.size();
+    std::vector<int> pos(m);
+    std::vector<int> depth(m);
+    for (size_t i = 0; i < m; i++) {
+        pos[i] = (int)((uint32_t)(events[i] >> 1) ^ 0x80000000u);
+        depth[i] = (events[i] & 1) ? -1 : 1;
+    }
+    prefixSumInPlace(depth);
+    
+    // Step 3: Sweep; depth[i] holds on [pos[i], pos[i+1]]
+    stats.max_depth = depth[0];
+    stats.max_depth_at = Interval{pos[0], pos[0]};
+    for (size_t i = 0; i + 1 < m; i++) {
+        int from = pos[i];
+        int to = pos[i + 1];
+        
+        if (depth[i] > 0) {
+            stats.covered_length += (long long)to - from;
+        } else if (to > from) {
+            stats.gaps.push_back(Interval{from, to});
+        }
+        
+        if (depth[i] > stats.max_depth) {
+            stats.max_depth = depth[i];
+            stats.max_depth_at = Interval{from, to};
+        }
+    }
+    
+    return stats;
+}
+
+/*
+DEMO: IntervalSet live updates
+DEMO: streaming merge of sorted run files
+DEMO: coverage analytics
+SCALING BENCHMARK: serial flat merge vs mergeParallel
+*/
+int main() {
+    IntervalSet live;
+    live.insert(1, 3);
+    live.insert(8, 10);
+    live.insert(15, 18);
+    live.insert(2, 6);  // Absorbs [1,3] -> [1,6]
+    std::cout << "Live set:";
+    for (const auto& iv : live.toVector()) {
+        std::cout << " [" << iv.start << "," << iv.end << "]";
+    }
+    std::cout << " (expected: [1,6] [8,10] [15,18])" << std::endl;
+    
+    live.remove(9, 16);  // Cuts [8,10] -> [8,9] and [15,18] -> [16,18]
+    Interval hit;
+    std::cout << "After remove(9,16): " << live.size() << " ranges, stab(17) = "
+              << (live.stab(17, hit) ? "[" + std::to_string(hit.start) + "," + std::to_string(hit.end) + "]" : "none")
+              << " (expected: 3 ranges, [16,18])" << std::endl;
+    std::cout << "Ranges overlapping [5,8]: " << live.overlapping(5, 8).size() 
+              << " (expected: 2)" << std::endl << std::endl;
+    
+    // Write three sorted runs to disk, then stream-merge them
+    std::vector<std::vector<Interval>> runs = {
+        {{1, 3}, {8, 10}, {20, 22}},
+        {{2, 6}, {15, 18}},
+        {{9, 12}, {30, 31}}
+    };
+    std::vector<std::string> paths;
+    for (size_t r = 0; r < runs.size(); r++) {
+        paths.push_back("/tmp/interval_run_" + std::to_string(r) + ".bin");
+        FILE* f = std::fopen(paths.back().c_str(), "wb");
+        std::fwrite(runs[r].data(), sizeof(Interval), runs[r].size(), f);
+        std::fclose(f);
+    }
+    std::cout << "Streamed merge:";
+    mergeSortedRuns(paths, [](const Interval& iv) {
+        std::cout << " [" << iv.start << "," << iv.end << "]";
+    });
+    std::cout << " (expected: [1,6] [8,12] [15,18] [20,22] [30,31])" << std::endl << std::endl;
+    for (const auto& path : paths) {
+        std::remove(path.c_str());
+    }
+    
+    // Coverage of [[1,3], [2,6], [4,5], [8,10], [15,18]]
+    CoverageStats cov = analyzeCoverage({{1, 3}, {2, 6}, {4, 5}, {8, 10}, {15, 18}});
+    std::cout << "Covered length: " << cov.covered_length << " (expected: 10)" << std::endl;
+    std::cout << "Gaps:";
+    for (const auto& gap : cov.gaps) {
+        std::cout << " [" << gap.start << "," << gap.end << "]";
+    }
+    std::cout << " (expected: [6,8] [10,15])" << std::endl;
+    std::cout << "Max depth: " << cov.max_depth << " at [" << cov.max_depth_at.start 
+              << "," << cov.max_depth_at.end << "] (expected: 2 at [2,3])" << std::endl << std::endl;
+    
+    const size_t N = 20000000;
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> start(0, 1000000000);
+    std::uniform_int_distribution<int> length(0, 100);
+    
+    std::vector<Interval> input(N);
+    for (auto& iv : input) {
+        iv.start = start(rng);
+        iv.end = iv.start + length(rng);
+    }
+    
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::duration d) { 
+        return std::chrono::duration<double, std::milli>(d).count(); 
+    };
+    Solution sol;
+    
+    std::vector<Interval> serial = input;
+    auto t0 = Clock::now();
+    sol.merge(serial);
+    double serial_ms = ms(Clock::now() - t0);
+    std::cout << "Intervals: " << N << ", merged: " << serial.size() << std::endl;
+    std::cout << "serial:     " << serial_ms << " ms" << std::endl;
+    
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        std::vector<Interval> parallel = input;
+        auto t1 = Clock::now();
+        sol.mergeParallel(parallel, threads);
+        double parallel_ms = ms(Clock::now() - t1);
+        
+        bool same = parallel.size() == serial.size() && 
+            std::equal(parallel.begin(), parallel.end(), serial.begin(), 
+                [](const Interval& a, const Interval& b) {
+                    return a.start == b.start && a.end == b.end;
+                });
+        std::cout << threads << " thread(s): " << parallel_ms << " ms, speedup " 
+                  << serial_ms / parallel_ms << "x, identical: " 
+                  << (same ? "yes" : "NO") << std::endl;
+    }
+    
+    return 0;
+}
\ No newline at end of file
@@ -17,12 +17,65 @@ OPTIMIZED APPROACH (Current Implementation):
 - upper_bound: first element > right boundary
 - Time Complexity: O(log n) per query
 - Space Complexity: O(1)
+
+BATCHED QUERIES (query_batch / query_and_batch / query_or_batch):
+- Each binary search step on a large array is a dependent cache miss
+- Branchless search: every query over the same array takes exactly the same
+  number of steps, so a block of queries can advance in lockstep
+- Interleaving 16 independent searches (with software prefetch of both
+  possible next probes) keeps many cache misses in flight at once
+- query_or shares bounds: with equal radii the union is one range
+  [min left, max right] minus the gap between the ranges if they don't
+  overlap, so it needs 2 searches (4 with a gap) instead of 6
+- Time Complexity: O(log n) per query, throughput bound by memory bandwidth
+
+CACHE-FRIENDLY LAYOUT (EytzingerIndex):
+- In a sorted array the first binary search steps jump across the whole
+  array, so almost every step is a cache miss once it exceeds L2
+- Eytzinger (BFS) order stores the implicit search tree level by level:
+  children of node k are 2k and 2k+1, so the top levels share a few hot
+  cache lines and the next 4 levels of a search sit 16k..16k+15: with the
+  array 64-byte aligned that is exactly 2 cache lines, both prefetched
+- The tree is padded with +inf to a perfect 2^h - 1 nodes, so a search
+  always takes h steps and ends at leaf index 2^h + (keys before the bound):
+  the sorted position falls out of the index, no rank array lookup
+- Both bounds of a range descend in lockstep, overlapping their misses
+- Time Complexity: O(log n) per query, Space Complexity: O(n) (8-16 bytes/point)
+
+DYNAMIC POINTS (DynamicPointSet):
+- A sorted vector needs an O(n) shift per insert/delete
+- Fenwick (binary indexed) tree over the compressed coordinates of every
+  point that may ever be present; each slot counts copies of that value
+- Range count = prefix(upper) - prefix(lower), both O(log n)
+- query_or generalizes to N centers: sort, merge overlapping ranges, sum
+- Time Complexity: O(log n) insert/erase/query, O(N log N + N log n) for
+  an N-way union; Space Complexity: O(u) for u distinct coordinates
+
+2D RANGE COUNTING (RangeCountTree2D):
+- Merge-sort tree: points sorted by x, segment tree over that order, every
+  node keeps the y values of its points sorted
+- Box count: the x-range splits into O(log n) nodes, each answers its y-range
+  with one binary search -> O(log² n)
+- Radius count: same decomposition; a node whose whole x-slab sees the circle
+  with y half-chord at least h_in (farthest x) and at most h_out (nearest x)
+  counts |dy| <= h_in directly and only recurses if some point falls
+  between h_in and h_out
+- Batched box/radius counts are split across threads
+- Space Complexity: O(n log n)
 */
 
 #include <iostream>
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <random>
+#include <chrono>
 
 // Count points within distance d from query_point
 // Time: O(log n), Space: O(1)
@@ -71,6 +124,515 @@ int query_or(std::vector<double>& points, double qp1, double qp2, double d){
     return count_A + count_B - count_intersection;
 }
 
+// ============================================================================
+// EYTZINGER LAYOUT INDEX
+// ============================================================================
+
+// std::vector storage aligned to a 64-byte cache line
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+    
+    CacheAlignedAllocator() = default;
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+    
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(64)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(64));
+    }
+    
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const CacheAlignedAllocator<U>&) const { return false; }
+};
+
+class EytzingerIndex {
+private:
+    // 1-based BFS order of a perfect tree (2^height - 1 slots, padded with
+    // +inf past the n real points); tree[0] unused
+    std::vector<double, CacheAlignedAllocator<double>> tree;
+    int n;
+    int height;
+    size_t leaves;  // 2^height: first index below the last level
+    
+    // In-order walk of the implicit tree fills it from the sorted array
+    // Time: O(2^height) = O(n)
+    void build(const std::vector<double>& sorted, size_t& next, size_t k) {
+        if (k >= leaves) 
+            return;
+        build(sorted, next, 2 * k);
+        tree[k] = next < (size_t)n ? sorted[next] : std::numeric_limits<double>::infinity();
+        next++;
+        build(sorted, next, 2 * k + 1);
+    }
+    
+    // Number of points in [left, right]
+    // Both bounds descend in lockstep so their cache misses overlap. In a
+    // perfect tree the node reached after 'height' steps, minus 2^height,
+    // is the count of keys before the bound: no rank lookup is needed
+    int countRange(double left, double right) const {
+        const double* t = tree.data();
+        size_t lo = 1, hi = 1;
+        for (int level = 0; level < height; level++) {
+            // The 16 nodes 4 levels down fill exactly 2 aligned cache lines
+            if (level + 4 < height) {
+                __builtin_prefetch(t + 16 * lo);
+                __builtin_prefetch(t + 16 * lo + 8);
+                __builtin_prefetch(t + 16 * hi);
+                __builtin_prefetch(t + 16 * hi + 8);
+            }
+            lo = 2 * lo + (t[lo] < left);    // First element >= left
+            hi = 2 * hi + (t[hi] <= right);  // First element > right
+        }
+        size_t first = std::min(lo - leaves, (size_t)n);
+        size_t last = std::min(hi - leaves, (size_t)n);
+        return (int)(last - first);
+    }
+
+public:
+    // Build from an already sorted points array
+    // Time: O(n)
+    EytzingerIndex(const std::vector<double>& sorted_points) 
+        : n(sorted_points.size()), height(0) {
+        while (((size_t)1 << height) <= (size_t)n) height++;
+        leaves = (size_t)1 << height;
+        tree.resize(leaves);
+        size_t next = 0;
+        build(sorted_points, next, 1);
+    }
+    
+    // Same semantics as query(points, query_point, d)
+    int query(double query_point, double d) const {
+        return countRange(query_point - d, query_point + d);
+    }
+    
+    // Same semantics as query_and(points, qp1, qp2, d)
+    int query_and(double qp1, double qp2, double d) const {
+        double left = std::max(qp1 - d, qp2 - d);
+        double right = std::min(qp1 + d, qp2 + d);
+        if (left > right) return 0;
+        return countRange(left, right);
+    }
+    
+    // Same semantics as query_or(points, qp1, qp2, d)
+    int query_or(double qp1, double qp2, double d) const {
+        return query(qp1, d) + query(qp2, d) - query_and(qp1, qp2, d);
+    }
+};
+
+// ============================================================================
+// DYNAMIC POINT SET (FENWICK TREE OVER COMPRESSED COORDINATES)
+// ============================================================================
+
+class DynamicPointSet {
+private:
+    std::vector<double> coords;  // Sorted distinct values that may be inserted
+    std::vector<int> fenwick;    // 1-based Fenwick tree over coords
+    std::vector<int> copies;     // copies[i] = how many times coords[i] is present
+    
+    // Slot of value x in coords; throws if x was not declared up front
+    size_t slot(double x) const {
+        auto it = std::lower_bound(coords.begin(), coords.end(), x);
+        if (it == coords.end() || *it != x) 
+            throw std::out_of_range("Point not in DynamicPointSet universe");
+        return it - coords.begin();
+    }
+    
+    // Add delta to slot i
+    // Time: O(log u)
+    void update(size_t i, int delta) {
+        for (size_t k = i + 1; k < fenwick.size(); k += k & (~k + 1)) {
+            fenwick[k] += delta;
+        }
+    }
+    
+    // Number of points stored in slots [0, i)
+    // Time: O(log u)
+    int prefix(size_t i) const {
+        int sum = 0;
+        for (size_t k = i; k > 0; k -= k & (~k + 1)) {
+            sum += fenwick[k];
+        }
+        return sum;
+    }
+    
+    // Number of points in [left, right]
+    int countRange(double left, double right) const {
+        if (left > right) return 0;
+        size_t lo = std::lower_bound(coords.begin(), coords.end(), left) - coords.begin();
+        size_t hi = std::upper_bound(coords.begin(), coords.end(), right) - coords.begin();
+        return prefix(hi) - prefix(lo);
+    }
+
+public:
+    // universe: every value that may ever be inserted (any order, duplicates ok)
+    // The set starts empty
+    // Time: O(u log u)
+    DynamicPointSet(std::vector<double> universe) : coords(std::move(universe)) {
+        std::sort(coords.begin(), coords.end());
+        coords.erase(std::unique(coords.begin(), coords.end()), coords.end());
+        fenwick.assign(coords.size() + 1, 0);
+        copies.assign(coords.size(), 0);
+    }
+    
+    // Add one copy of x
+    // Time: O(log u)
+    void insert(double x) {
+        size_t i = slot(x);
+        copies[i]++;
+        update(i, 1);
+    }
+    
+    // Remove one copy of x
+    // Returns: false if x is not present
+    // Time: O(log u)
+    bool erase(double x) {
+        size_t i = slot(x);
+        if (copies[i] == 0) 
+            return false;
+        copies[i]--;
+        update(i, -1);
+        return true;
+    }
+    
+    // Same semantics as query(points, query_point, d)
+    int query(double query_point, double d) const {
+        return countRange(query_point - d, query_point + d);
+    }
+    
+    // Same semantics as query_and(points, qp1, qp2, d)
+    int query_and(double qp1, double qp2, double d) const {
+        return countRange(std::max(qp1, qp2) - d, std::min(qp1, qp2) + d);
+    }
+    
+    // Points within d of at least one query point (N-way union)
+    // Sorted centers give ranges sorted by start; overlapping ones are merged
+    // Time: O(N log N + N log u)
+    int query_or(std::vector<double> query_points, double d) const {
+        std::sort(query_points.begin(), query_points.end());
+        
+        int total = 0;
+        size_t i = 0;
+        while (i < query_points.size()) {
+            double left = query_points[i] - d;
+            double right = query_points[i] + d;
+            
+            // Extend while the next range overlaps the current one
+            while (i + 1 < query_points.size() && query_points[i + 1] - d <= right) {
+                right = query_points[++i] + d;
+            }
+            total += countRange(left, right);
+            i++;
+        }
+        return total;
+    }
+    
+    // Same semantics as query_or(points, qp1, qp2, d)
+    int query_or(double qp1, double qp2, double d) const {
+        return query_or(std::vector<double>{qp1, qp2}, d);
+    }
+};
+
+// ============================================================================
+// 2D RANGE COUNTING (MERGE-SORT TREE)
+// ============================================================================
+
+struct Point2D {
+    double x, y;
+};
+
+struct Box2D {
+    double min_x, min_y, max_x, max_y;
+};
+
+struct Circle2D {
+    double x, y, r;
+};
+
+class RangeCountTree2D {
+private:
+    std::vector<double> xs;                   // Point x values, sorted
+    std::vector<double> ys_by_x;              // y of each point in x order
+    std::vector<std::vector<double>> node_ys; // node -> sorted y of its points
+    int n;
+    
+    // Node covers points [lo, hi) in x order
+    // Time: O(n log n)
+    void build(int node, int lo, int hi) {
+        if (hi - lo == 1) {
+            node_ys[node] = {ys_by_x[lo]};
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        build(2 * node, lo, mid);
+        build(2 * node + 1, mid, hi);
+        
+        const auto& a = node_ys[2 * node];
+        const auto& b = node_ys[2 * node + 1];
+        node_ys[node].resize(a.size() + b.size());
+        std::merge(a.begin(), a.end(), b.begin(), b.end(), node_ys[node].begin());
+    }
+    
+    // Points of a node with y in [y0, y1]
+    int countY(int node, double y0, double y1) const {
+        if (y0 > y1) return 0;
+        const auto& ys = node_ys[node];
+        return std::upper_bound(ys.begin(), ys.end(), y1) - 
+               std::lower_bound(ys.begin(), ys.end(), y0);
+    }
+    
+    // Points in x-order range [l, r) with y in [y0, y1]
+    int countBox(int node, int lo, int hi, int l, int r, double y0, double y1) const {
+        if (r <= lo || hi <= l) return 0;
+        if (l <= lo && hi <= r) return countY(node, y0, y1);
+        int mid = (lo + hi) / 2;
+        return countBox(2 * node, lo, mid, l, r, y0, y1) + 
+               countBox(2 * node + 1, mid, hi, l, r, y0, y1);
+    }
+    
+    // Points in x-order range [l, r) inside circle c
+    int countDisk(int node, int lo, int hi, int l, int r, const Circle2D& c) const {
+        if (r <= lo || hi <= l) return 0;
+        
+        if (l <= lo && hi <= r) {
+            // Leaf: exact test
+            if (hi - lo == 1) {
+                double dx = xs[lo] - c.x, dy = ys_by_x[lo] - c.y;
+                return dx * dx + dy * dy <= c.r * c.r;
+            }
+            
+            // Nearest and farthest |dx| over the node's x-slab
+            double dx_lo = std::abs(xs[lo] - c.x);
+            double dx_hi = std::abs(xs[hi - 1] - c.x);
+            double dx_far = std::max(dx_lo, dx_hi);
+            double dx_near = (xs[lo] <= c.x && c.x <= xs[hi - 1]) ? 0.0 : std::min(dx_lo, dx_hi);
+            
+            if (dx_far <= c.r) {
+                // Every point with |dy| <= h_in is inside, none with |dy| > h_out
+                double h_in = std::sqrt(c.r * c.r - dx_far * dx_far);
+                double h_out = std::sqrt(c.r * c.r - dx_near * dx_near);
+                int inner = countY(node, c.y - h_in, c.y + h_in);
+                if (inner == countY(node, c.y - h_out, c.y + h_out)) 
+                    return inner;
+            }
+            // Points left between h_in and h_out: refine in the children
+            if (countY(node, c.y - c.r, c.y + c.r) == 0) 
+                return 0;
+        }
+        
+        int mid = (lo + hi) / 2;
+        return countDisk(2 * node, lo, mid, l, r, c) + 
+               countDisk(2 * node + 1, mid, hi, l, r, c);
+    }
+    
+    // Run count(query) for every query, split across threads
+    template <typename Query, typename Count>
+    static std::vector<int> runBatch(const std::vector<Query>& queries, 
+                                     unsigned num_threads, Count count) {
+        std::vector<int> result(queries.size());
+        num_threads = std::max(1u, num_threads);
+        
+        std::vector<std::thread> pool;
+        for (unsigned t = 0; t < num_threads; t++) {
+            size_t begin = queries.size() * t / num_threads;
+            size_t end = queries.size() * (t + 1) / num_threads;
+            pool.emplace_back([&, begin, end]() {
+                for (size_t i = begin; i < end; i++) {
+                    result[i] = count(queries[i]);
+                }
+            });
+        }
+        for (auto& th : pool) {
+            th.join();
+        }
+        return result;
+    }
+
+public:
+    // Time: O(n log n), Space: O(n log n)
+    RangeCountTree2D(std::vector<Point2D> points) : n(points.size()) {
+        std::sort(points.begin(), points.end(), 
+            [](const Point2D& a, const Point2D& b) { return a.x < b.x; });
+        for (const auto& p : points) {
+            xs.push_back(p.x);
+            ys_by_x.push_back(p.y);
+        }
+        if (n > 0) {
+            node_ys.resize(4 * n);
+            build(1, 0, n);
+        }
+    }
+    
+    // Number of points inside the box (borders included)
+    // Time: O(log² n)
+    int countBox(const Box2D& box) const {
+        if (n == 0 || box.min_x > box.max_x) return 0;
+        int l = std::lower_bound(xs.begin(), xs.end(), box.min_x) - xs.begin();
+        int r = std::upper_bound(xs.begin(), xs.end(), box.max_x) - xs.begin();
+        return countBox(1, 0, n, l, r, box.min_y, box.max_y);
+    }
+    
+    // Number of points within distance c.r of (c.x, c.y)
+    // Time: O(log² n) plus refinement near the circle boundary
+    int countRadius(const Circle2D& c) const {
+        if (n == 0 || c.r < 0) return 0;
+        int l = std::lower_bound(xs.begin(), xs.end(), c.x - c.r) - xs.begin();
+        int r = std::upper_bound(xs.begin(), xs.end(), c.x + c.r) - xs.begin();
+        return countDisk(1, 0, n, l, r, c);
+    }
+    
+    std::vector<int> countBoxBatch(const std::vector<Box2D>& boxes, 
+                                   unsigned num_threads = std::thread::hardware_concurrency()) const {
+        return runBatch(boxes, num_threads, [this](const Box2D& b) { return countBox(b); });
+    }
+    
+    std::vector<int> countRadiusBatch(const std::vector<Circle2D>& circles, 
+                                      unsigned num_threads = std::thread::hardware_concurrency()) const {
+        return runBatch(circles, num_threads, [this](const Circle2D& c) { return countRadius(c); });
+    }
+};
+
+// ============================================================================
+// BATCHED QUERIES
+// ============================================================================
+
+// Searches advanced together in one block
+const size_t BATCH_BLOCK = 16;
+
+// Rank of every key in the sorted points array:
+// Upper = false -> number of points <  key (lower_bound index)
+// Upper = true  -> number of points <= key (upper_bound index)
+// Branchless binary search, BATCH_BLOCK searches interleaved per step
+// Time: O(count · log n)
+template <bool Upper>
+void batchRank(const std::vector<double>& points, const double* keys, size_t count, int* out) {
+    const double* data = points.data();
+    size_t n = points.size();
+    if (n == 0) {
+        std::fill(out, out + count, 0);
+        return;
+    }
+    
+    for (size_t q0 = 0; q0 < count; q0 += BATCH_BLOCK) {
+        size_t m = std::min(BATCH_BLOCK, count - q0);
+        const double* base[BATCH_BLOCK];
+        for (size_t j = 0; j < m; j++) {
+            base[j] = data;
+        }
+        
+        // Same step sequence for every search: halve the window each round
+        size_t len = n;
+        while (len > 1) {
+            size_t half = len / 2;
+            size_t next_half = (len - half) / 2;
+            for (size_t j = 0; j < m; j++) {
+                double key = keys[q0 + j];
+                bool right = Upper ? (base[j][half] <= key) : (base[j][half] < key);
+                base[j] += right ? half : 0;  // Compiles to cmov, no branch
+                
+                // Prefetch both candidates of the next step
+                __builtin_prefetch(base[j] + next_half);
+                __builtin_prefetch(base[j] + half + next_half);
+            }
+            len -= half;
+        }
+        
+        // One element left in each window: final comparison
+        for (size_t j = 0; j < m; j++) {
+            double key = keys[q0 + j];
+            bool past = Upper ? (*base[j] <= key) : (*base[j] < key);
+            out[q0 + j] = (int)(base[j] - data) + past;
+        }
+    }
+}
+
+// Batched query(): count points within d of every query point
+// Time: O(q · log n)
+std::vector<int> query_batch(const std::vector<double>& points, 
+                             const std::vector<double>& query_points, double d) {
+    size_t q = query_points.size();
+    std::vector<double> lefts(q), rights(q);
+    for (size_t i = 0; i < q; i++) {
+        lefts[i] = query_points[i] - d;
+        rights[i] = query_points[i] + d;
+    }
+    
+    std::vector<int> low(q), high(q);
+    batchRank<false>(points, lefts.data(), q, low.data());
+    batchRank<true>(points, rights.data(), q, high.data());
+    
+    for (size_t i = 0; i < q; i++) {
+        high[i] -= low[i];
+    }
+    return high;
+}
+
+// Batched query_and(): count points in both ranges of every (qp1, qp2) pair
+// Time: O(q · log n)
+std::vector<int> query_and_batch(const std::vector<double>& points, 
+                                 const std::vector<std::pair<double, double>>& pairs, double d) {
+    size_t q = pairs.size();
+    std::vector<double> lefts(q), rights(q);
+    for (size_t i = 0; i < q; i++) {
+        lefts[i] = std::max(pairs[i].first, pairs[i].second) - d;
+        rights[i] = std::min(pairs[i].first, pairs[i].second) + d;
+    }
+    
+    std::vector<int> low(q), high(q);
+    batchRank<false>(points, lefts.data(), q, low.data());
+    batchRank<true>(points, rights.data(), q, high.data());
+    
+    // Empty intersection (left > right) gives high <= low: clamp to 0
+    for (size_t i = 0; i < q; i++) {
+        high[i] = std::max(0, high[i] - low[i]);
+    }
+    return high;
+}
+
+// Batched query_or(): count points in either range of every (qp1, qp2) pair
+// Union = [min - d, max + d] minus the open gap (min + d, max - d) if any
+// Time: O(q · log n), 2 searches per query plus 2 per query with a gap
+std::vector<int> query_or_batch(const std::vector<double>& points, 
+                                const std::vector<std::pair<double, double>>& pairs, double d) {
+    size_t q = pairs.size();
+    std::vector<double> lefts(q), rights(q);
+    std::vector<double> gap_lefts, gap_rights;  // Only queries whose ranges are disjoint
+    std::vector<size_t> gap_owner;
+    for (size_t i = 0; i < q; i++) {
+        double lo = std::min(pairs[i].first, pairs[i].second);
+        double hi = std::max(pairs[i].first, pairs[i].second);
+        lefts[i] = lo - d;
+        rights[i] = hi + d;
+        
+        if (lo + d < hi - d) {
+            gap_rights.push_back(lo + d);   // Gap starts after this (upper_bound)
+            gap_lefts.push_back(hi - d);    // and ends before this (lower_bound)
+            gap_owner.push_back(i);
+        }
+    }
+    
+    std::vector<int> low(q), high(q);
+    batchRank<false>(points, lefts.data(), q, low.data());
+    batchRank<true>(points, rights.data(), q, high.data());
+    
+    size_t g = gap_owner.size();
+    std::vector<int> gap_begin(g), gap_end(g);
+    batchRank<true>(points, gap_rights.data(), g, gap_begin.data());
+    batchRank<false>(points, gap_lefts.data(), g, gap_end.data());
+    
+    for (size_t i = 0; i < q; i++) {
+        high[i] -= low[i];
+    }
+    for (size_t k = 0; k < g; k++) {
+        high[gap_owner[k]] -= gap_end[k] - gap_begin[k];
+    }
+    return high;
+}
+
 int main() {
     std::vector<double> points = {0.0, 1.0, 1.5, 2.0, 2.5};
     
@@ -86,5 +648,122 @@ int main() {
     int result3 = query_or(points, 0.5, 2.0, 1.0);
     std::cout << "query_or(0.5, 2.0, 1.0): " << result3 << std::endl;
     
+    // Dynamic set: same points, then insert and erase
+    DynamicPointSet dynamic({0.0, 1.0, 1.5, 2.0, 2.5, 3.0});
+    for (double p : points) dynamic.insert(p);
+    std::cout << "\nDynamic query(2.0, 1.0): " << dynamic.query(2.0, 1.0) << " (expected: 4)" << std::endl;
+    dynamic.insert(3.0);
+    dynamic.erase(1.0);
+    std::cout << "After insert(3.0), erase(1.0): query(2.0, 1.0) = " << dynamic.query(2.0, 1.0) 
+              << " (expected: 4)" << std::endl;
+    std::cout << "query_or({0.0, 2.0, 3.0}, 0.5) = " << dynamic.query_or({0.0, 2.0, 3.0}, 0.5) 
+              << " (expected: 5)" << std::endl;
+    
+    // Batched queries: check against the scalar versions and compare throughput
+    const size_t N = 1 << 24;   // 16M points (128 MB), well past L2/L3
+    const size_t Q = 1 << 20;   // 1M queries
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> coord(0.0, 1e6);
+    
+    std::vector<double> big(N);
+    for (auto& p : big) p = coord(rng);
+    std::sort(big.begin(), big.end());
+    
+    std::vector<double> qps(Q);
+    std::vector<std::pair<double, double>> pairs(Q);
+    for (size_t i = 0; i < Q; i++) {
+        qps[i] = coord(rng);
+        pairs[i] = {qps[i], qps[i] + coord(rng) * 1e-4};
+    }
+    double d = 5.0;
+    
+    using Clock = std::chrono::steady_clock;
+    auto ms = [](Clock::duration t) { 
+        return std::chrono::duration<double, std::milli>(t).count(); 
+    };
+    
+    auto t0 = Clock::now();
+    std::vector<int> scalar(Q), scalar_or(Q);
+    for (size_t i = 0; i < Q; i++) scalar[i] = query(big, qps[i], d);
+    auto t1 = Clock::now();
+    std::vector<int> batched = query_batch(big, qps, d);
+    auto t2 = Clock::now();
+    for (size_t i = 0; i < Q; i++) scalar_or[i] = query_or(big, pairs[i].first, pairs[i].second, d);
+    auto t3 = Clock::now();
+    std::vector<int> batched_or = query_or_batch(big, pairs, d);
+    auto t4 = Clock::now();
+    std::vector<int> batched_and = query_and_batch(big, pairs, d);
+    
+    bool same = batched == scalar && batched_or == scalar_or;
+    for (size_t i = 0; i < Q && same; i++) {
+        same = batched_and[i] == query_and(big, pairs[i].first, pairs[i].second, d);
+    }
+    
+    std::cout << "\n=== BATCHED: " << N << " points, " << Q << " queries ===" << std::endl;
+    std::cout << "query:          " << ms(t1 - t0) << " ms" << std::endl;
+    std::cout << "query_batch:    " << ms(t2 - t1) << " ms" << std::endl;
+    std::cout << "query_or:       " << ms(t3 - t2) << " ms" << std::endl;
+    std::cout << "query_or_batch: " << ms(t4 - t3) << " ms" << std::endl;
+    std::cout << "Results match:  " << (same ? "yes" : "NO") << std::endl;
+    
+    // Eytzinger layout vs binary search on the sorted array
+    auto t5 = Clock::now();
+    EytzingerIndex eytzinger(big);
+    auto t6 = Clock::now();
+    std::vector<int> eyt(Q);
+    for (size_t i = 0; i < Q; i++) eyt[i] = eytzinger.query(qps[i], d);
+    auto t7 = Clock::now();
+    
+    same = eyt == scalar;
+    for (size_t i = 0; i < Q && same; i++) {
+        same = eytzinger.query_or(pairs[i].first, pairs[i].second, d) == scalar_or[i];
+    }
+    
+    std::cout << "\n=== EYTZINGER LAYOUT ===" << std::endl;
+    std::cout << "build:          " << ms(t6 - t5) << " ms" << std::endl;
+    std::cout << "query:          " << ms(t7 - t6) << " ms (sorted array: " 
+              << ms(t1 - t0) << " ms)" << std::endl;
+    std::cout << "Results match:  " << (same ? "yes" : "NO") << std::endl;
+    
+    // 2D box and radius counts vs brute force
+    const size_t N2 = 1 << 20;
+    const size_t Q2 = 100000;
+    const size_t BRUTE_Q2 = 200;  // Brute force checks a prefix of the queries
+    std::vector<Point2D> pts2(N2);
+    for (auto& p : pts2) p = {coord(rng), coord(rng)};
+    std::vector<Box2D> boxes(Q2);
+    std::vector<Circle2D> circles(Q2);
+    for (size_t i = 0; i < Q2; i++) {
+        double x = coord(rng), y = coord(rng);
+        boxes[i] = {x, y, x + 5000, y + 5000};
+        circles[i] = {x, y, 5000};
+    }
+    
+    auto t8 = Clock::now();
+    RangeCountTree2D tree2(pts2);
+    auto t9 = Clock::now();
+    std::vector<int> box_counts = tree2.countBoxBatch(boxes);
+    auto t10 = Clock::now();
+    std::vector<int> disk_counts = tree2.countRadiusBatch(circles);
+    auto t11 = Clock::now();
+    
+    same = true;
+    for (size_t i = 0; i < BRUTE_Q2 && same; i++) {
+        int in_box = 0, in_disk = 0;
+        for (const auto& p : pts2) {
+            in_box += p.x >= boxes[i].min_x && p.x <= boxes[i].max_x && 
+                      p.y >= boxes[i].min_y && p.y <= boxes[i].max_y;
+            double dx = p.x - circles[i].x, dy = p.y - circles[i].y;
+            in_disk += dx * dx + dy * dy <= circles[i].r * circles[i].r;
+        }
+        same = in_box == box_counts[i] && in_disk == disk_counts[i];
+    }
+    
+    std::cout << "\n=== 2D COUNTS: " << N2 << " points, " << Q2 << " queries ===" << std::endl;
+    std::cout << "build:          " << ms(t9 - t8) << " ms" << std::endl;
+    std::cout << "box batch:      " << ms(t10 - t9) << " ms" << std::endl;
+    std::cout << "radius batch:   " << ms(t11 - t10) << " ms" << std::endl;
+    std::cout << "Results match:  " << (same ? "yes" : "NO") << std::endl;
+    
     return 0;
 }
\ No newline at end of file